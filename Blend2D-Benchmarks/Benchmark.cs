@@ -0,0 +1,61 @@
+﻿using System;
+using System.Diagnostics;
+
+namespace Benchmarks
+{
+    internal static class Benchmark
+    {
+        #region -- const --
+
+        private const int WarmupRuns = 2;
+
+        private const int MeasuredRuns = 5;
+
+        #endregion -- const --
+
+        #region -- public methods --
+
+        // Returns the best of several runs in milliseconds. Warm-up runs let
+        // the JIT, the core allocator and Blend2D's caches settle first.
+        public static double Measure(Action action)
+        {
+            for (int i = 0; i < WarmupRuns; i++)
+            {
+                action();
+            }
+
+            var best = double.MaxValue;
+
+            for (int i = 0; i < MeasuredRuns; i++)
+            {
+                GC.Collect();
+                GC.WaitForPendingFinalizers();
+
+                var watch = Stopwatch.StartNew();
+
+                action();
+
+                watch.Stop();
+                best = Math.Min(best, watch.Elapsed.TotalMilliseconds);
+            }
+
+            return best;
+        }
+
+        public static void Header(string title)
+        {
+            Console.WriteLine();
+            Console.WriteLine(title);
+            Console.WriteLine(new string('-', title.Length));
+        }
+
+        public static void Report(string variant, long items, double milliseconds)
+        {
+            var perSecond = milliseconds > 0.0 ? items / (milliseconds / 1000.0) : 0.0;
+
+            Console.WriteLine("{0,-36} {1,10:N0} {2,12:N2} ms {3,16:N0} /s", variant, items, milliseconds, perSecond);
+        }
+
+        #endregion -- public methods --
+    }
+}
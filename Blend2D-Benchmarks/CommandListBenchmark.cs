@@ -0,0 +1,132 @@
+﻿using System;
+using Blend2D;
+
+namespace Benchmarks
+{
+    // Immediate BLContext calls against recording into a BLCommandList and
+    // replaying it, for small fills and strokes with periodic style changes.
+    internal static class CommandListBenchmark
+    {
+        #region -- const --
+
+        private const int ImageSize = 1024;
+
+        private const int PrimitiveSize = 8;
+
+        #endregion -- const --
+
+        #region -- public methods --
+
+        public static void Run()
+        {
+            Benchmark.Header("Command list: immediate vs. recorded submission");
+
+            using (var image = new BLImage(ImageSize, ImageSize, BLFormat.PRGB32))
+            {
+                foreach (var count in new[] { 1000, 10000, 100000 })
+                {
+                    var rects = CreateRects(count);
+
+                    using (var list = new BLCommandList())
+                    {
+                        Benchmark.Report("immediate", count, Benchmark.Measure(() => DrawImmediate(image, rects)));
+                        Benchmark.Report("record", count, Benchmark.Measure(() => Record(list, rects)));
+
+                        Record(list, rects);
+
+                        Benchmark.Report("replay", count, Benchmark.Measure(() => Replay(image, list)));
+                        Benchmark.Report("record + replay", count, Benchmark.Measure(() =>
+                        {
+                            Record(list, rects);
+                            Replay(image, list);
+                        }));
+                    }
+                }
+            }
+        }
+
+        #endregion -- public methods --
+
+        #region -- private methods --
+
+        private static BLRect[] CreateRects(int count)
+        {
+            var random = new Random(1);
+            var rects = new BLRect[count];
+
+            for (int i = 0; i < count; i++)
+            {
+                rects[i] = new BLRect(random.Next(ImageSize - PrimitiveSize), random.Next(ImageSize - PrimitiveSize), PrimitiveSize, PrimitiveSize);
+            }
+
+            return rects;
+        }
+
+        private static BLRgba32 ColorOf(int index)
+        {
+            return new BLRgba32(0xFF000000u | unchecked((uint)index * 0x9E3779B1u) >> 8);
+        }
+
+        private static void DrawImmediate(BLImage image, BLRect[] rects)
+        {
+            using (var context = new BLContext(image))
+            {
+                for (int i = 0; i < rects.Length; i++)
+                {
+                    var rect = rects[i];
+
+                    if ((i & 15) == 0)
+                    {
+                        context.SetFillStyle(ColorOf(i));
+                    }
+
+                    if ((i & 3) == 0)
+                    {
+                        context.StrokeLine(rect.X, rect.Y, rect.X + rect.Width, rect.Y + rect.Height);
+                    }
+                    else
+                    {
+                        context.FillRect(rect.X, rect.Y, rect.Width, rect.Height);
+                    }
+                }
+
+                context.End();
+            }
+        }
+
+        private static void Record(BLCommandList list, BLRect[] rects)
+        {
+            list.Clear();
+
+            for (int i = 0; i < rects.Length; i++)
+            {
+                var rect = rects[i];
+
+                if ((i & 15) == 0)
+                {
+                    list.SetFillStyle(ColorOf(i));
+                }
+
+                if ((i & 3) == 0)
+                {
+                    list.StrokeLine(rect.X, rect.Y, rect.X + rect.Width, rect.Y + rect.Height);
+                }
+                else
+                {
+                    list.FillRect(rect.X, rect.Y, rect.Width, rect.Height);
+                }
+            }
+        }
+
+        private static void Replay(BLImage image, BLCommandList list)
+        {
+            using (var context = new BLContext(image))
+            {
+                list.Replay(context);
+                context.End();
+            }
+        }
+
+        #endregion -- private methods --
+    }
+}
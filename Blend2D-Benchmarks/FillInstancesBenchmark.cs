@@ -0,0 +1,132 @@
+﻿using System;
+using Blend2D;
+
+namespace Benchmarks
+{
+    // BLContext.FillInstances against the per-call loop it replaces, one
+    // managed/native transition per matrix change and fill. Scatters a small
+    // path over the image by offset, and by matrix with a color per instance.
+    internal static class FillInstancesBenchmark
+    {
+        #region -- const --
+
+        private const int ImageSize = 1024;
+
+        private const double ShapeSize = 6.0;
+
+        #endregion -- const --
+
+        #region -- public methods --
+
+        public static void Run()
+        {
+            Benchmark.Header("Path instances: per-call loop vs. FillInstances");
+
+            using (var image = new BLImage(ImageSize, ImageSize, BLFormat.PRGB32))
+            using (var shape = CreateShape())
+            {
+                foreach (var count in new[] { 10000, 100000, 1000000 })
+                {
+                    var offsets = CreateOffsets(count);
+                    var matrices = CreateMatrices(offsets);
+                    var colors = CreateColors(count);
+
+                    Benchmark.Report("offsets, per-call loop", count, Benchmark.Measure(() => Draw(image, context => FillOffsetsLoop(context, shape, offsets))));
+                    Benchmark.Report("offsets, FillInstances", count, Benchmark.Measure(() => Draw(image, context => context.FillInstances(shape, offsets))));
+                    Benchmark.Report("matrices + colors, per-call loop", count, Benchmark.Measure(() => Draw(image, context => FillMatricesLoop(context, shape, matrices, colors))));
+                    Benchmark.Report("matrices + colors, FillInstances", count, Benchmark.Measure(() => Draw(image, context => context.FillInstances(shape, matrices, colors))));
+                }
+            }
+        }
+
+        #endregion -- public methods --
+
+        #region -- private methods --
+
+        private static BLPath CreateShape()
+        {
+            var shape = new BLPath();
+
+            shape.MoveTo(0, -ShapeSize);
+            shape.LineTo(ShapeSize, ShapeSize);
+            shape.LineTo(-ShapeSize, ShapeSize);
+            shape.Close();
+
+            return shape;
+        }
+
+        private static BLPoint[] CreateOffsets(int count)
+        {
+            var random = new Random(1);
+            var offsets = new BLPoint[count];
+
+            for (int i = 0; i < count; i++)
+            {
+                offsets[i] = new BLPoint(random.NextDouble() * ImageSize, random.NextDouble() * ImageSize);
+            }
+
+            return offsets;
+        }
+
+        private static BLMatrix2D[] CreateMatrices(BLPoint[] offsets)
+        {
+            var matrices = new BLMatrix2D[offsets.Length];
+
+            for (int i = 0; i < offsets.Length; i++)
+            {
+                var angle = i * 0.01;
+                var cos = Math.Cos(angle);
+                var sin = Math.Sin(angle);
+
+                matrices[i] = new BLMatrix2D(cos, sin, -sin, cos, offsets[i].X, offsets[i].Y);
+            }
+
+            return matrices;
+        }
+
+        private static BLRgba32[] CreateColors(int count)
+        {
+            var colors = new BLRgba32[count];
+
+            for (int i = 0; i < count; i++)
+            {
+                colors[i] = new BLRgba32(0xFF000000u | unchecked((uint)i * 0x9E3779B1u) >> 8);
+            }
+
+            return colors;
+        }
+
+        private static void Draw(BLImage image, Action<BLContext> draw)
+        {
+            using (var context = new BLContext(image))
+            {
+                draw(context);
+                context.End();
+            }
+        }
+
+        private static void FillOffsetsLoop(BLContext context, BLPath shape, BLPoint[] offsets)
+        {
+            for (int i = 0; i < offsets.Length; i++)
+            {
+                context.Translate(offsets[i].X, offsets[i].Y);
+                context.FillPath(shape);
+                context.Translate(-offsets[i].X, -offsets[i].Y);
+            }
+        }
+
+        private static void FillMatricesLoop(BLContext context, BLPath shape, BLMatrix2D[] matrices, BLRgba32[] colors)
+        {
+            for (int i = 0; i < matrices.Length; i++)
+            {
+                context.SetFillStyle(colors[i]);
+                context.Save();
+                context.Transform(matrices[i]);
+                context.FillPath(shape);
+                context.Restore();
+            }
+        }
+
+        #endregion -- private methods --
+    }
+}
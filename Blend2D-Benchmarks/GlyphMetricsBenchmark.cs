@@ -0,0 +1,115 @@
+﻿using System;
+using System.Text;
+using Blend2D;
+
+namespace Benchmarks
+{
+    // BLFont.GetGlyphMetrics against the managed path it replaced, which
+    // copied the glyph content, placement data and glyph bounds into managed
+    // arrays and combined them in a managed loop. Text is shaped once, only
+    // the metrics are measured.
+    internal static class GlyphMetricsBenchmark
+    {
+        #region -- const --
+
+        private const string FontFile = "Resources\\NotoSans-Regular.ttf";
+
+        private const string Sample = "The quick brown fox jumps over the lazy dog. 0123456789 ";
+
+        #endregion -- const --
+
+        #region -- types --
+
+        // BLGlyphMetrics as the old path filled it, its fields are not writable
+        // outside the assembly.
+        private struct ManagedGlyphMetrics
+        {
+            public uint GlyphId;
+            public double Advance;
+            public double LeadingBearing;
+            public double TrailingBearing;
+            public BLBox BoundingBox;
+        }
+
+        #endregion -- types --
+
+        #region -- public methods --
+
+        public static void Run()
+        {
+            Benchmark.Header("Glyph metrics: managed copies vs. native pass");
+
+            using (var face = new BLFontFace(FontFile))
+            using (var font = new BLFont(face, 16.0f))
+            {
+                foreach (var count in new[] { 1000, 10000, 100000 })
+                {
+                    using (var glyphBuffer = new BLGlyphBuffer())
+                    {
+                        glyphBuffer.SetText(CreateText(count));
+                        font.Shape(glyphBuffer);
+
+                        var glyphCount = (int)glyphBuffer.Size;
+                        var reused = new BLGlyphMetrics[glyphCount];
+
+                        Benchmark.Report("managed copies (before)", glyphCount, Benchmark.Measure(() => GetManagedMetrics(font, glyphBuffer)));
+                        Benchmark.Report("native pass", glyphCount, Benchmark.Measure(() =>
+                        {
+                            BLGlyphMetrics[] metrics = null;
+                            font.GetGlyphMetrics(glyphBuffer, ref metrics);
+                        }));
+                        Benchmark.Report("native pass, reused array", glyphCount, Benchmark.Measure(() => font.GetGlyphMetrics(glyphBuffer, reused, 0)));
+                    }
+                }
+            }
+        }
+
+        #endregion -- public methods --
+
+        #region -- private methods --
+
+        private static string CreateText(int length)
+        {
+            var text = new StringBuilder(length + Sample.Length);
+
+            while (text.Length < length)
+            {
+                text.Append(Sample);
+            }
+
+            return text.ToString(0, length);
+        }
+
+        private static ManagedGlyphMetrics[] GetManagedMetrics(BLFont font, BLGlyphBuffer glyphBuffer)
+        {
+            var matrix = font.Matrix;
+            var mx = matrix.M00;
+            var my = matrix.M11;
+            var size = glyphBuffer.Size;
+            var glyphData = glyphBuffer.Content;
+            var placementData = glyphBuffer.PlacementData;
+
+            BLBoxI[] glyphBounds = null;
+
+            font.GetGlyphBounds(glyphBuffer, glyphData, ref glyphBounds, size);
+
+            var metrics = new ManagedGlyphMetrics[(int)size];
+
+            for (int i = 0; i < metrics.Length; i++)
+            {
+                var advance = placementData[i].Advance.X;
+                var bounds = glyphBounds[i];
+
+                metrics[i].GlyphId = glyphData[i];
+                metrics[i].Advance = advance * mx;
+                metrics[i].LeadingBearing = bounds.X0 * mx;
+                metrics[i].TrailingBearing = (advance - bounds.X1) * mx;
+                metrics[i].BoundingBox = new BLBox(bounds.X0 * mx, -(bounds.Y0 * my), bounds.X1 * mx, -(bounds.Y1 * my));
+            }
+
+            return metrics;
+        }
+
+        #endregion -- private methods --
+    }
+}
@@ -0,0 +1,110 @@
+﻿using System;
+using System.IO;
+using Blend2D;
+
+namespace Benchmarks
+{
+    // BLImage.WriteToData against encoding to a file, with and without
+    // reading the file back, which is what callers did to get encoded bytes
+    // before. Small images are encoded several times per run, throughput is
+    // reported in pixels.
+    internal static class ImageEncodeBenchmark
+    {
+        #region -- const --
+
+        private const long PixelsPerRun = 4L * 1024 * 1024;
+
+        #endregion -- const --
+
+        #region -- public methods --
+
+        public static void Run()
+        {
+            Benchmark.Header("Image encoding: memory vs. file");
+
+            var fileName = Path.GetTempFileName();
+
+            try
+            {
+                foreach (var codecName in new[] { "BMP", "PNG" })
+                {
+                    using (var codec = new BLImageCodec())
+                    {
+                        codec.FindByName(codecName);
+
+                        foreach (var size in new[] { 256, 1024, 2048 })
+                        {
+                            using (var image = CreateImage(size))
+                            using (var reused = new BLByteArray())
+                            {
+                                var repeat = (int)Math.Max(1, PixelsPerRun / ((long)size * size));
+                                var pixels = (long)repeat * size * size;
+                                var prefix = $"{codecName} {size}x{size}, ";
+
+                                Benchmark.Report(prefix + "file", pixels, Benchmark.Measure(() => Repeat(repeat, () => image.WriteToFile(fileName, codec))));
+                                Benchmark.Report(prefix + "file + read back", pixels, Benchmark.Measure(() => Repeat(repeat, () =>
+                                {
+                                    image.WriteToFile(fileName, codec);
+                                    File.ReadAllBytes(fileName);
+                                })));
+                                Benchmark.Report(prefix + "new BLByteArray", pixels, Benchmark.Measure(() => Repeat(repeat, () =>
+                                {
+                                    using (var bytes = new BLByteArray())
+                                    {
+                                        image.WriteToData(bytes, codec);
+                                    }
+                                })));
+                                Benchmark.Report(prefix + "reused BLByteArray", pixels, Benchmark.Measure(() => Repeat(repeat, () => image.WriteToData(reused, codec))));
+                                Benchmark.Report(prefix + "reused BLByteArray + ToArray", pixels, Benchmark.Measure(() => Repeat(repeat, () =>
+                                {
+                                    image.WriteToData(reused, codec);
+                                    reused.ToArray();
+                                })));
+                            }
+                        }
+                    }
+                }
+            }
+            finally
+            {
+                File.Delete(fileName);
+            }
+        }
+
+        #endregion -- public methods --
+
+        #region -- private methods --
+
+        // Random rectangles, so PNG has something to compress but no noise.
+        private static BLImage CreateImage(int size)
+        {
+            var random = new Random(1);
+            var image = new BLImage(size, size, BLFormat.PRGB32);
+
+            using (var context = new BLContext(image))
+            {
+                context.FillAll();
+
+                for (int i = 0; i < size; i++)
+                {
+                    context.SetFillStyle(new BLRgba32(0xFF000000u | (uint)random.Next(0x1000000)));
+                    context.FillRect(random.Next(size), random.Next(size), 1 + random.Next(size / 8), 1 + random.Next(size / 8));
+                }
+
+                context.End();
+            }
+
+            return image;
+        }
+
+        private static void Repeat(int count, Action action)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                action();
+            }
+        }
+
+        #endregion -- private methods --
+    }
+}
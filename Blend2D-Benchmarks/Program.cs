@@ -0,0 +1,48 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace Benchmarks
+{
+    static class Program
+    {
+        #region -- fields --
+
+        private static readonly Dictionary<string, Action> benchmarks = new Dictionary<string, Action>(StringComparer.OrdinalIgnoreCase)
+        {
+            { "commandlist", CommandListBenchmark.Run },
+            { "fillinstances", FillInstancesBenchmark.Run },
+            { "glyphmetrics", GlyphMetricsBenchmark.Run },
+            { "imageencode", ImageEncodeBenchmark.Run },
+            { "textruncache", TextRunCacheBenchmark.Run },
+        };
+
+        #endregion -- fields --
+
+        #region -- main --
+
+        // Runs the benchmarks named on the command line, or all of them.
+        static int Main(string[] args)
+        {
+            var names = args.Length > 0 ? args : benchmarks.Keys.ToArray();
+
+            foreach (var name in names)
+            {
+                if (!benchmarks.ContainsKey(name))
+                {
+                    Console.WriteLine("Unknown benchmark '{0}', available: {1}.", name, string.Join(", ", benchmarks.Keys));
+                    return 1;
+                }
+            }
+
+            foreach (var name in names)
+            {
+                benchmarks[name]();
+            }
+
+            return 0;
+        }
+
+        #endregion -- main --
+    }
+}
@@ -0,0 +1,111 @@
+﻿using System;
+using Blend2D;
+
+namespace Benchmarks
+{
+    // Frame time of a label-heavy frame drawn with BLContext.FillText, with
+    // and without a BLTextRunCache. Repeated labels are the steady state of a
+    // map or chart, unique labels change every frame and only miss.
+    internal static class TextRunCacheBenchmark
+    {
+        #region -- const --
+
+        private const string FontFile = "Resources\\NotoSans-Regular.ttf";
+
+        private const int ImageSize = 1024;
+
+        private const int DistinctLabels = 256;
+
+        // More frames of unique labels than Benchmark.Measure runs, so no frame
+        // repeats a previous one.
+        private const int UniqueFrames = 8;
+
+        #endregion -- const --
+
+        #region -- public methods --
+
+        public static void Run()
+        {
+            Benchmark.Header("Text run cache: label frames with the cache off and on");
+
+            using (var image = new BLImage(ImageSize, ImageSize, BLFormat.PRGB32))
+            using (var face = new BLFontFace(FontFile))
+            using (var font = new BLFont(face, 12.0f))
+            {
+                foreach (var count in new[] { 1000, 5000, 20000 })
+                {
+                    var positions = CreatePositions(count);
+                    var repeated = new[] { CreateLabels(count, DistinctLabels, 0) };
+                    var unique = new string[UniqueFrames][];
+
+                    for (int i = 0; i < UniqueFrames; i++)
+                    {
+                        unique[i] = CreateLabels(count, count, i * count);
+                    }
+
+                    Compare("repeated labels", image, font, positions, repeated);
+                    Compare("unique labels", image, font, positions, unique);
+                }
+            }
+        }
+
+        #endregion -- public methods --
+
+        #region -- private methods --
+
+        private static void Compare(string scenario, BLImage image, BLFont font, BLPoint[] positions, string[][] frames)
+        {
+            var frame = 0;
+
+            Benchmark.Report(scenario + ", cache off", positions.Length, Benchmark.Measure(() => DrawFrame(image, font, positions, frames[frame++ % frames.Length], null)));
+
+            var cache = new BLTextRunCache();
+
+            frame = 0;
+
+            Benchmark.Report(scenario + ", cache on", positions.Length, Benchmark.Measure(() => DrawFrame(image, font, positions, frames[frame++ % frames.Length], cache)));
+
+            Console.WriteLine("     hits {0:N0}, misses {1:N0}, evictions {2:N0}, {3:N0} entries, {4:N0} KB held", cache.Hits, cache.Misses, cache.Evictions, cache.Count, cache.BytesHeld / 1024);
+        }
+
+        private static BLPoint[] CreatePositions(int count)
+        {
+            var random = new Random(1);
+            var positions = new BLPoint[count];
+
+            for (int i = 0; i < count; i++)
+            {
+                positions[i] = new BLPoint(random.Next(ImageSize - 100), 12 + random.Next(ImageSize - 12));
+            }
+
+            return positions;
+        }
+
+        private static string[] CreateLabels(int count, int distinct, int first)
+        {
+            var labels = new string[count];
+
+            for (int i = 0; i < count; i++)
+            {
+                labels[i] = "Station " + (first + i % distinct).ToString("D5");
+            }
+
+            return labels;
+        }
+
+        private static void DrawFrame(BLImage image, BLFont font, BLPoint[] positions, string[] labels, BLTextRunCache cache)
+        {
+            using (var context = new BLContext(image))
+            {
+                for (int i = 0; i < positions.Length; i++)
+                {
+                    context.FillText(positions[i], font, labels[i], cache);
+                }
+
+                context.End();
+            }
+        }
+
+        #endregion -- private methods --
+    }
+}
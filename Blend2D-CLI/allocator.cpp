@@ -0,0 +1,224 @@
+// Compiled without /clr and without the precompiled header, so native tools
+// such as the allocator benchmark can build it as well.
+#include "allocator.h"
+
+// Native cores are small fixed-size structs, so they are carved out of slabs
+// per size class and recycled through lock-free lists. Finalizers release
+// cores on the finalizer thread, which rules out thread-local free lists.
+namespace Blend2D
+{
+	static const size_t CoreSlabSize = 64 * 1024;
+	static const size_t CoreMinBlockSize = 16;
+	static const size_t CoreSizeClassCount = 4;
+
+	// A zero-filled SLIST_HEADER is an empty list, so static storage needs no
+	// initializer. Slabs are never returned to the heap.
+	static SLIST_HEADER coreFreeLists[CoreSizeClassCount];
+
+	static volatile LONG64 coreAllocationCount;
+	static volatile LONG64 coreLiveCount;
+	static volatile LONG64 coreSlabCount;
+	static volatile LONG64 coreHeapAllocationCount;
+	static volatile LONG64 corePendingReleaseCount;
+
+	static size_t CoreSizeClassOf(size_t size)
+	{
+		size_t blockSize = CoreMinBlockSize;
+
+		for (size_t i = 0; i < CoreSizeClassCount; i++, blockSize <<= 1)
+		{
+			if (size <= blockSize)
+			{
+				return i;
+			}
+		}
+
+		return CoreSizeClassCount;
+	}
+
+	static bool AllocCoreSlab(size_t sizeClass)
+	{
+		size_t blockSize = CoreMinBlockSize << sizeClass;
+		auto slab = static_cast<uint8_t*>(_aligned_malloc(CoreSlabSize, MEMORY_ALLOCATION_ALIGNMENT));
+
+		if (slab == nullptr)
+		{
+			return false;
+		}
+
+		for (size_t offset = 0; offset < CoreSlabSize; offset += blockSize)
+		{
+			InterlockedPushEntrySList(&coreFreeLists[sizeClass], reinterpret_cast<PSLIST_ENTRY>(slab + offset));
+		}
+
+		InterlockedIncrement64(&coreSlabCount);
+		return true;
+	}
+
+	void* AllocCore(size_t size)
+	{
+		size_t sizeClass = CoreSizeClassOf(size);
+		void* block = nullptr;
+
+		if (sizeClass < CoreSizeClassCount)
+		{
+			while ((block = InterlockedPopEntrySList(&coreFreeLists[sizeClass])) == nullptr)
+			{
+				if (!AllocCoreSlab(sizeClass))
+				{
+					return nullptr;
+				}
+			}
+		}
+		else
+		{
+			block = _aligned_malloc(size, MEMORY_ALLOCATION_ALIGNMENT);
+
+			if (block == nullptr)
+			{
+				return nullptr;
+			}
+
+			InterlockedIncrement64(&coreHeapAllocationCount);
+		}
+
+		InterlockedIncrement64(&coreAllocationCount);
+		InterlockedIncrement64(&coreLiveCount);
+		return block;
+	}
+
+	void FreeCore(void* block, size_t size)
+	{
+		size_t sizeClass = CoreSizeClassOf(size);
+
+		if (sizeClass < CoreSizeClassCount)
+		{
+			InterlockedPushEntrySList(&coreFreeLists[sizeClass], static_cast<PSLIST_ENTRY>(block));
+		}
+		else
+		{
+			_aligned_free(block);
+		}
+
+		InterlockedDecrement64(&coreLiveCount);
+	}
+
+	// Cores released by finalizers are destroyed on a dedicated native thread,
+	// so freeing large pixel buffers never stalls the finalizer thread.
+	struct BLReleaseNode
+	{
+		SLIST_ENTRY entry;
+		void* core;
+		size_t size;
+		BLCoreDestroyFunc destroy;
+	};
+
+	static SLIST_HEADER releaseQueue;
+	static HANDLE releaseEvent;
+	static INIT_ONCE releaseInit = INIT_ONCE_STATIC_INIT;
+
+	// Nodes are bookkeeping, not object cores, so they are recycled through
+	// their own list and stay out of the core allocator statistics.
+	static SLIST_HEADER releaseNodeFreeList;
+
+	static BLReleaseNode* AllocReleaseNode()
+	{
+		auto node = reinterpret_cast<BLReleaseNode*>(InterlockedPopEntrySList(&releaseNodeFreeList));
+
+		if (node == nullptr)
+		{
+			node = static_cast<BLReleaseNode*>(_aligned_malloc(sizeof(BLReleaseNode), MEMORY_ALLOCATION_ALIGNMENT));
+		}
+
+		return node;
+	}
+
+	static void FreeReleaseNode(BLReleaseNode* node)
+	{
+		InterlockedPushEntrySList(&releaseNodeFreeList, &node->entry);
+	}
+
+	static DWORD WINAPI ReleaseThreadProc(LPVOID)
+	{
+		for (;;)
+		{
+			WaitForSingleObject(releaseEvent, INFINITE);
+
+			PSLIST_ENTRY entry = InterlockedFlushSList(&releaseQueue);
+
+			while (entry != nullptr)
+			{
+				auto node = reinterpret_cast<BLReleaseNode*>(entry);
+				entry = entry->Next;
+
+				node->destroy(node->core);
+				FreeCore(node->core, node->size);
+				FreeReleaseNode(node);
+
+				InterlockedDecrement64(&corePendingReleaseCount);
+			}
+		}
+	}
+
+	static BOOL CALLBACK InitReleaseThread(PINIT_ONCE, PVOID, PVOID*)
+	{
+		releaseEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+
+		if (releaseEvent == nullptr)
+		{
+			return FALSE;
+		}
+
+		HANDLE thread = CreateThread(nullptr, 0, ReleaseThreadProc, nullptr, 0, nullptr);
+
+		if (thread == nullptr)
+		{
+			CloseHandle(releaseEvent);
+			releaseEvent = nullptr;
+			return FALSE;
+		}
+
+		CloseHandle(thread);
+		return TRUE;
+	}
+
+	void ReleaseCoreDeferred(void* core, size_t size, BLCoreDestroyFunc destroy)
+	{
+		BLReleaseNode* node = nullptr;
+
+		if (InitOnceExecuteOnce(&releaseInit, InitReleaseThread, nullptr, nullptr))
+		{
+			node = AllocReleaseNode();
+		}
+
+		if (node == nullptr)
+		{
+			destroy(core);
+			FreeCore(core, size);
+			return;
+		}
+
+		node->core = core;
+		node->size = size;
+		node->destroy = destroy;
+
+		InterlockedIncrement64(&corePendingReleaseCount);
+		InterlockedPushEntrySList(&releaseQueue, &node->entry);
+		SetEvent(releaseEvent);
+	}
+
+	// Plain 64-bit reads can tear on x86, the compare exchange reads atomically.
+	static LONG64 ReadCounter(volatile LONG64* counter)
+	{
+		return InterlockedCompareExchange64(counter, 0, 0);
+	}
+
+	void GetCoreAllocatorStats(BLCoreAllocatorStats* stats)
+	{
+		stats->allocationCount = ReadCounter(&coreAllocationCount);
+		stats->liveCount = ReadCounter(&coreLiveCount);
+		stats->slabCount = ReadCounter(&coreSlabCount);
+		stats->heapAllocationCount = ReadCounter(&coreHeapAllocationCount);
+		stats->pendingReleaseCount = ReadCounter(&corePendingReleaseCount);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// Allocator of the native cores held by BLObjectPointer. It has no managed
+// dependencies, allocator.cpp is compiled as native code.
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <malloc.h>
+#include <stdint.h>
+
+namespace Blend2D
+{
+	struct BLCoreAllocatorStats
+	{
+		int64_t allocationCount;
+		int64_t liveCount;
+		int64_t slabCount;
+		int64_t heapAllocationCount;
+		int64_t pendingReleaseCount;
+	};
+
+	typedef void (*BLCoreDestroyFunc)(void* core);
+
+	extern void* AllocCore(size_t size);
+	extern void FreeCore(void* block, size_t size);
+	extern void ReleaseCoreDeferred(void* core, size_t size, BLCoreDestroyFunc destroy);
+	extern void GetCoreAllocatorStats(BLCoreAllocatorStats* stats);
+}
@@ -1,6 +1,11 @@
 #include "pch.h"
 #include "api.h"
 #include "context.h"
+#include "atlas.h"
+#include "layer.h"
+#include "strokecache.h"
+#include "glyphatlas.h"
+#include "fontmanager.h"
 
 using namespace System;
 
@@ -18,6 +23,37 @@ namespace Blend2D
 		return value;
 	}
 
+	// Used by classes supporting ErrorMode, they hide the global CheckResult
+	// with a member forwarding here so all of their calls honor the mode. In
+	// Accumulate mode only the first error is kept, later ones are counted.
+	BLResultCode CheckResult(BLResult result, BLErrorMode errorMode, BLResultCode% accumulatedError, size_t% accumulatedErrorCount)
+	{
+		if (result == BL_SUCCESS || errorMode == BLErrorMode::Throw)
+		{
+			return CheckResult(result);
+		}
+
+		if (accumulatedErrorCount++ == 0)
+		{
+			accumulatedError = (BLResultCode)result;
+		}
+
+		return (BLResultCode)result;
+	}
+
+	void CheckArrayRange(Array^ items, int index, int count)
+	{
+		if (items == nullptr)
+		{
+			throw gcnew ArgumentNullException("items");
+		}
+
+		if (index < 0 || count < 0 || index > items->Length - count)
+		{
+			throw gcnew ArgumentOutOfRangeException("index");
+		}
+	}
+
 	template<typename T>
 	array<T>^ ConvertToArray(const void* data, size_t count)
 	{
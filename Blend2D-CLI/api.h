@@ -145,6 +145,29 @@ namespace Blend2D
 		REFLECT_X_REPEAT_Y = BL_EXTEND_MODE_REFLECT_X_REPEAT_Y,
 	};
 
+	//! Error handling mode of objects that support deferred errors.
+	public enum class BLErrorMode : UInt32
+	{
+		//! Every failed call throws `InvalidOperationException` [default].
+		Throw = 0,
+		//! Failed calls are recorded and can be inspected later.
+		Accumulate = 1,
+	};
+
+	//! File read flags.
+	[FlagsAttribute]
+	public enum class BLFileReadFlags : UInt32
+	{
+		//! No flags.
+		None = 0,
+		//! Use memory mapping to read the content of the file.
+		MmapEnabled = BL_FILE_READ_MMAP_ENABLED,
+		//! Avoid memory mapping of small files.
+		MmapAvoidSmall = BL_FILE_READ_MMAP_AVOID_SMALL,
+		//! Do not fallback to regular read if memory mapping fails.
+		MmapNoFallback = BL_FILE_READ_MMAP_NO_FALLBACK,
+	};
+
 	public enum class BLFormat : UInt32
 	{
 		//! None or invalid pixel format.
@@ -180,9 +203,21 @@ namespace Blend2D
 
 	public:
 
+		// Blend2D expects UTF-8, an ANSI conversion would mangle file names
+		// outside of the current code page.
 		StringConvert(String^ string)
 		{
-			ptr = Marshal::StringToHGlobalAnsi(string);
+			if (string == nullptr)
+			{
+				return;
+			}
+
+			auto bytes = System::Text::Encoding::UTF8->GetBytes(string);
+
+			ptr = Marshal::AllocHGlobal(bytes->Length + 1);
+
+			Marshal::Copy(bytes, 0, ptr, bytes->Length);
+			Marshal::WriteByte(ptr, bytes->Length, 0);
 		}
 
 		~StringConvert()
@@ -228,4 +263,8 @@ namespace Blend2D
 	extern array<T>^ ConvertToArray(const void* data, size_t count);
 
 	extern BLResultCode CheckResult(BLResult result);
+
+	extern BLResultCode CheckResult(BLResult result, BLErrorMode errorMode, BLResultCode% accumulatedError, size_t% accumulatedErrorCount);
+
+	extern void CheckArrayRange(Array^ items, int index, int count);
 }
\ No newline at end of file
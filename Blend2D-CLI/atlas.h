@@ -0,0 +1,406 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "geometry.h"
+#include "image.h"
+#include "context.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+
+namespace Blend2D
+{
+	// Packs many small images into one PRGB32 image so they can be drawn with
+	// a single BLContext::BlitImages call. Placement uses a bottom-left
+	// skyline packer, images are never moved once added.
+	public ref class BLImageAtlas sealed
+	{
+	public:
+
+		literal int DefaultPadding = 1;
+
+	private:
+
+		value struct SkylineSegment
+		{
+			int x;
+			int y;
+			int width;
+
+			SkylineSegment(int x, int y, int width)
+				: x(x), y(y), width(width)
+			{
+			}
+		};
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLImage^ image;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLRectI bounds;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool ownsImage;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int padding;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		List<SkylineSegment>^ skyline;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int count = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t usedArea = 0;
+
+	public:
+
+		BLImageAtlas(int width, int height)
+			: BLImageAtlas(width, height, DefaultPadding)
+		{
+		}
+
+		// Padding is left free to the right and below every image, so scaled
+		// or filtered blits do not bleed into neighbours.
+		BLImageAtlas(int width, int height, int padding)
+		{
+			if (width <= 0 || height <= 0)
+			{
+				throw gcnew ArgumentOutOfRangeException(width <= 0 ? "width" : "height");
+			}
+
+			if (padding < 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("padding");
+			}
+
+			this->image = gcnew BLImage(width, height, BLFormat::PRGB32);
+			this->bounds = BLRectI(0, 0, width, height);
+			this->ownsImage = true;
+			this->padding = padding;
+			this->skyline = gcnew List<SkylineSegment>();
+
+			Clear();
+		}
+
+	internal:
+
+		// Packs into bounds of an image owned by the caller, so several atlases
+		// can share one image and be cleared independently.
+		BLImageAtlas(BLImage^ image, BLRectI bounds, int padding)
+		{
+			if (image == nullptr)
+			{
+				throw gcnew ArgumentNullException("image");
+			}
+
+			if (bounds.Width <= 0 || bounds.Height <= 0 || bounds.X < 0 || bounds.Y < 0 || bounds.X + bounds.Width > image->Width || bounds.Y + bounds.Height > image->Height)
+			{
+				throw gcnew ArgumentOutOfRangeException("bounds");
+			}
+
+			this->image = image;
+			this->bounds = bounds;
+			this->ownsImage = false;
+			this->padding = padding;
+			this->skyline = gcnew List<SkylineSegment>();
+
+			Clear();
+		}
+
+	public:
+
+		~BLImageAtlas()
+		{
+			if (ownsImage)
+			{
+				delete image;
+			}
+		}
+
+	public:
+
+		// Reserves an area without copying pixels, the caller renders into it.
+		bool TryReserve(int width, int height, BLRectI% rect)
+		{
+			if (width <= 0 || height <= 0)
+			{
+				throw gcnew ArgumentOutOfRangeException(width <= 0 ? "width" : "height");
+			}
+
+			int index, x, y;
+
+			if (!FindPosition(width + padding, height + padding, index, x, y))
+			{
+				return false;
+			}
+
+			Insert(index, x, y, width + padding, height + padding);
+
+			rect = BLRectI(x, y, width, height);
+			count++;
+			usedArea += (int64_t)width * height;
+			return true;
+		}
+
+		bool TryAdd(BLImage^ source, BLRectI% rect)
+		{
+			if (!TryReserve(source->Width, source->Height, rect))
+			{
+				return false;
+			}
+
+			auto context = CreateContext();
+
+			try
+			{
+				context->BlitImage(BLPointI(rect.X, rect.Y), source);
+				context->End();
+			}
+			finally
+			{
+				delete context;
+			}
+
+			return true;
+		}
+
+		BLRectI Add(BLImage^ source)
+		{
+			BLRectI rect;
+
+			if (!TryAdd(source, rect))
+			{
+				throw gcnew InvalidOperationException("Atlas is full.");
+			}
+
+			return rect;
+		}
+
+		// Adds all sources with a single rendering context, tallest first for a
+		// tighter packing. Returned areas are in the order of sources.
+		array<BLRectI>^ AddRange(array<BLImage^>^ sources)
+		{
+			auto order = gcnew array<int>(sources->Length);
+			auto heights = gcnew array<int>(sources->Length);
+			auto rects = gcnew array<BLRectI>(sources->Length);
+
+			for (int i = 0; i < sources->Length; i++)
+			{
+				order[i] = i;
+				heights[i] = -sources[i]->Height;
+			}
+
+			Array::Sort(heights, order);
+
+			auto context = CreateContext();
+
+			try
+			{
+				for (int i = 0; i < order->Length; i++)
+				{
+					auto source = sources[order[i]];
+
+					if (!TryReserve(source->Width, source->Height, rects[order[i]]))
+					{
+						throw gcnew InvalidOperationException("Atlas is full.");
+					}
+
+					context->BlitImage(BLPointI(rects[order[i]].X, rects[order[i]].Y), source);
+				}
+
+				context->End();
+			}
+			finally
+			{
+				delete context;
+			}
+
+			return rects;
+		}
+
+		void Clear()
+		{
+			skyline->Clear();
+			skyline->Add(SkylineSegment(bounds.X, bounds.Y, bounds.Width));
+
+			count = 0;
+			usedArea = 0;
+
+			auto context = CreateContext();
+
+			try
+			{
+				context->ClearRect(bounds);
+				context->End();
+			}
+			finally
+			{
+				delete context;
+			}
+		}
+
+	private:
+
+		BLContext^ CreateContext()
+		{
+			auto context = gcnew BLContext(image);
+
+			context->CompOp = BLCompOp::SourceCopy;
+
+			return context;
+		}
+
+		// Returns the lowest y at which a width x height area starting at
+		// segment index fits, or -1.
+		int Fit(int index, int width, int height)
+		{
+			auto segment = skyline[index];
+
+			if (segment.x + width > bounds.X + bounds.Width)
+			{
+				return -1;
+			}
+
+			auto y = segment.y;
+			auto remaining = width;
+
+			for (int i = index; remaining > 0; i++)
+			{
+				y = Math::Max(y, skyline[i].y);
+
+				if (y + height > bounds.Y + bounds.Height)
+				{
+					return -1;
+				}
+
+				remaining -= skyline[i].width;
+			}
+
+			return y;
+		}
+
+		bool FindPosition(int width, int height, int% index, int% x, int% y)
+		{
+			auto bestY = Int32::MaxValue;
+			auto bestWidth = Int32::MaxValue;
+
+			index = -1;
+
+			for (int i = 0; i < skyline->Count; i++)
+			{
+				auto fitY = Fit(i, width, height);
+
+				if (fitY >= 0 && (fitY < bestY || (fitY == bestY && skyline[i].width < bestWidth)))
+				{
+					index = i;
+					x = skyline[i].x;
+					y = fitY;
+					bestY = fitY;
+					bestWidth = skyline[i].width;
+				}
+			}
+
+			return index >= 0;
+		}
+
+		void Insert(int index, int x, int y, int width, int height)
+		{
+			skyline->Insert(index, SkylineSegment(x, y + height, width));
+
+			auto right = x + width;
+
+			// Segments covered by the new one are trimmed or removed.
+			for (int i = index + 1; i < skyline->Count; )
+			{
+				auto segment = skyline[i];
+
+				if (segment.x >= right)
+				{
+					break;
+				}
+
+				auto shrink = right - segment.x;
+
+				if (segment.width <= shrink)
+				{
+					skyline->RemoveAt(i);
+					continue;
+				}
+
+				skyline[i] = SkylineSegment(segment.x + shrink, segment.y, segment.width - shrink);
+				break;
+			}
+
+			// Neighbours at the same height are merged.
+			for (int i = 0; i < skyline->Count - 1; )
+			{
+				if (skyline[i].y == skyline[i + 1].y)
+				{
+					skyline[i] = SkylineSegment(skyline[i].x, skyline[i].y, skyline[i].width + skyline[i + 1].width);
+					skyline->RemoveAt(i + 1);
+				}
+				else
+				{
+					i++;
+				}
+			}
+		}
+
+	public:
+
+		property BLImage^ Image
+		{
+			BLImage^ get()
+			{
+				return image;
+			}
+		}
+
+		property int Width
+		{
+			int get()
+			{
+				return bounds.Width;
+			}
+		}
+
+		property int Height
+		{
+			int get()
+			{
+				return bounds.Height;
+			}
+		}
+
+		property int Padding
+		{
+			int get()
+			{
+				return padding;
+			}
+		}
+
+		property int Count
+		{
+			int get()
+			{
+				return count;
+			}
+		}
+
+		// Fraction of the atlas covered by images, padding excluded.
+		property double Occupancy
+		{
+			double get()
+			{
+				return (double)usedArea / ((int64_t)bounds.Width * bounds.Height);
+			}
+		}
+	};
+}
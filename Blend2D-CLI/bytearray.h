@@ -0,0 +1,174 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+
+namespace Blend2D
+{
+	// Native byte buffer (BLArray<uint8_t>) that encoders write into. Its
+	// capacity is kept when it is written again, so one instance can serve
+	// many encode calls without allocations. Data and AsStream expose the
+	// content in place; they are valid until the buffer is modified.
+	public ref class BLByteArray sealed : public BLObject
+	{
+	private:
+
+		typedef ::BLArray<uint8_t> ImplType;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<ImplType> impl;
+
+	public:
+
+		BLByteArray()
+			: BLObject()
+		{
+		}
+
+		BLByteArray(int64_t capacity)
+			: BLObject()
+		{
+			Reserve(capacity);
+		}
+
+	internal:
+
+		operator ImplType* ()
+		{
+			if (Object::ReferenceEquals(this, nullptr))
+			{
+				return nullptr;
+			}
+
+			return impl;
+		}
+
+		bool Recycle() override
+		{
+			return blArrayClear(this) == BL_SUCCESS;
+		}
+
+		void UpdateMemoryPressure()
+		{
+			SetMemoryPressure((int64_t)impl->capacity());
+		}
+
+	public:
+
+		// Removes the content and keeps the capacity.
+		void Clear()
+		{
+			CheckResult(blArrayClear(this));
+		}
+
+		void Reserve(int64_t capacity)
+		{
+			if (capacity < 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("capacity");
+			}
+
+			CheckResult(blArrayReserve(this, (size_t)capacity));
+
+			UpdateMemoryPressure();
+		}
+
+		void Shrink()
+		{
+			CheckResult(blArrayShrink(this));
+
+			UpdateMemoryPressure();
+		}
+
+		// Returns a read-only stream over the content without copying it.
+		UnmanagedMemoryStream^ AsStream()
+		{
+			auto size = (int64_t)impl->size();
+
+			return gcnew UnmanagedMemoryStream((unsigned char*)impl->data(), size, size, FileAccess::Read);
+		}
+
+		void WriteTo(Stream^ stream)
+		{
+			if (stream == nullptr)
+			{
+				throw gcnew ArgumentNullException("stream");
+			}
+
+			auto source = AsStream();
+
+			try
+			{
+				source->CopyTo(stream);
+			}
+			finally
+			{
+				delete source;
+			}
+		}
+
+		int CopyTo(array<Byte>^ destination, int index)
+		{
+			auto size = (int)impl->size();
+
+			CheckArrayRange(destination, index, size);
+
+			if (size > 0)
+			{
+				Marshal::Copy(IntPtr((void*)impl->data()), destination, index, size);
+			}
+
+			return size;
+		}
+
+		array<Byte>^ ToArray()
+		{
+			auto result = gcnew array<Byte>((int)impl->size());
+
+			CopyTo(result, 0);
+
+			return result;
+		}
+
+	public:
+
+		property IntPtr Data
+		{
+			IntPtr get()
+			{
+				return IntPtr((void*)impl->data());
+			}
+		}
+
+		property int64_t Size
+		{
+			int64_t get()
+			{
+				return (int64_t)impl->size();
+			}
+		}
+
+		property int64_t Capacity
+		{
+			int64_t get()
+			{
+				return (int64_t)impl->capacity();
+			}
+		}
+
+		property bool IsEmpty
+		{
+			bool get()
+			{
+				return impl->empty();
+			}
+		}
+	};
+}
@@ -0,0 +1,233 @@
+#include "pch.h"
+#include "api.h"
+#include "commandlist.h"
+
+// Replay runs entirely in native code so a whole command list costs a single
+// managed/native transition instead of one per recorded call.
+#pragma managed(push, off)
+
+namespace Blend2D
+{
+	static bool IsArrayGeometry(uint32_t geometryType)
+	{
+		switch (geometryType)
+		{
+		case BL_GEOMETRY_TYPE_POLYLINEI:
+		case BL_GEOMETRY_TYPE_POLYLINED:
+		case BL_GEOMETRY_TYPE_POLYGONI:
+		case BL_GEOMETRY_TYPE_POLYGOND:
+		case BL_GEOMETRY_TYPE_ARRAY_VIEW_BOXI:
+		case BL_GEOMETRY_TYPE_ARRAY_VIEW_BOXD:
+		case BL_GEOMETRY_TYPE_ARRAY_VIEW_RECTI:
+		case BL_GEOMETRY_TYPE_ARRAY_VIEW_RECTD:
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	static BLResult ReplayGeometry(BLContextCore* self, uint32_t op, const uint8_t* payload)
+	{
+		auto geometry = reinterpret_cast<const BLCommandGeometry*>(payload);
+		const void* geometryData = geometry + 1;
+
+		BLArrayView<uint8_t> view;
+
+		if (IsArrayGeometry(geometry->geometryType))
+		{
+			auto count = static_cast<const uint64_t*>(geometryData);
+
+			view.reset(reinterpret_cast<const uint8_t*>(count + 1), (size_t)*count);
+			geometryData = &view;
+		}
+
+		if (op == BL_COMMAND_OP_FILL_GEOMETRY)
+		{
+			return blContextFillGeometry(self, geometry->geometryType, geometryData);
+		}
+
+		return blContextStrokeGeometry(self, geometry->geometryType, geometryData);
+	}
+
+	BLResult ReplayCommands(BLContextCore* self, const BLCommandBuffer* buffer)
+	{
+		const uint8_t* ptr = buffer->data;
+		const uint8_t* end = ptr + buffer->size;
+		const BLVariantCore* objects = buffer->objects;
+
+		while (ptr < end)
+		{
+			auto header = reinterpret_cast<const BLCommandHeader*>(ptr);
+			auto payload = reinterpret_cast<const uint8_t*>(header + 1);
+
+			BLResult result = BL_SUCCESS;
+
+			switch (header->op)
+			{
+			case BL_COMMAND_OP_SAVE:
+				result = blContextSave(self, nullptr);
+				break;
+
+			case BL_COMMAND_OP_RESTORE:
+				result = blContextRestore(self, nullptr);
+				break;
+
+			case BL_COMMAND_OP_MATRIX_OP:
+			{
+				auto matrixOp = reinterpret_cast<const BLCommandMatrixOp*>(payload);
+				result = blContextMatrixOp(self, matrixOp->opType, matrixOp->opType == BL_MATRIX2D_OP_RESET ? nullptr : matrixOp->data);
+				break;
+			}
+
+			case BL_COMMAND_OP_USER_TO_META:
+				result = blContextUserToMeta(self);
+				break;
+
+			case BL_COMMAND_OP_CLIP_TO_RECT:
+				result = blContextClipToRectD(self, reinterpret_cast<const ::BLRect*>(payload));
+				break;
+
+			case BL_COMMAND_OP_RESTORE_CLIPPING:
+				result = blContextRestoreClipping(self);
+				break;
+
+			case BL_COMMAND_OP_CLEAR_ALL:
+				result = blContextClearAll(self);
+				break;
+
+			case BL_COMMAND_OP_CLEAR_RECT:
+				result = blContextClearRectD(self, reinterpret_cast<const ::BLRect*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_COMP_OP:
+				result = blContextSetCompOp(self, *reinterpret_cast<const uint32_t*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_GLOBAL_ALPHA:
+				result = blContextSetGlobalAlpha(self, *reinterpret_cast<const double*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_FILL_ALPHA:
+				result = blContextSetFillAlpha(self, *reinterpret_cast<const double*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_FILL_RULE:
+				result = blContextSetFillRule(self, *reinterpret_cast<const uint32_t*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_FILL_STYLE_RGBA32:
+				result = blContextSetFillStyleRgba32(self, *reinterpret_cast<const uint32_t*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_FILL_STYLE_RGBA64:
+				result = blContextSetFillStyleRgba64(self, *reinterpret_cast<const uint64_t*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_FILL_STYLE_OBJECT:
+				result = blContextSetFillStyleObject(self, &objects[*reinterpret_cast<const uint32_t*>(payload)]);
+				break;
+
+			case BL_COMMAND_OP_SET_STROKE_ALPHA:
+				result = blContextSetStrokeAlpha(self, *reinterpret_cast<const double*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_STROKE_STYLE_RGBA32:
+				result = blContextSetStrokeStyleRgba32(self, *reinterpret_cast<const uint32_t*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_STROKE_STYLE_RGBA64:
+				result = blContextSetStrokeStyleRgba64(self, *reinterpret_cast<const uint64_t*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_STROKE_STYLE_OBJECT:
+				result = blContextSetStrokeStyleObject(self, &objects[*reinterpret_cast<const uint32_t*>(payload)]);
+				break;
+
+			case BL_COMMAND_OP_SET_STROKE_WIDTH:
+				result = blContextSetStrokeWidth(self, *reinterpret_cast<const double*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_STROKE_MITER_LIMIT:
+				result = blContextSetStrokeMiterLimit(self, *reinterpret_cast<const double*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_STROKE_JOIN:
+				result = blContextSetStrokeJoin(self, *reinterpret_cast<const uint32_t*>(payload));
+				break;
+
+			case BL_COMMAND_OP_SET_STROKE_CAPS:
+				result = blContextSetStrokeCaps(self, *reinterpret_cast<const uint32_t*>(payload));
+				break;
+
+			case BL_COMMAND_OP_FILL_ALL:
+				result = blContextFillAll(self);
+				break;
+
+			case BL_COMMAND_OP_FILL_GEOMETRY:
+			case BL_COMMAND_OP_STROKE_GEOMETRY:
+				result = ReplayGeometry(self, header->op, payload);
+				break;
+
+			case BL_COMMAND_OP_FILL_PATH:
+				result = blContextFillPathD(self, reinterpret_cast<const BLPathCore*>(&objects[*reinterpret_cast<const uint32_t*>(payload)]));
+				break;
+
+			case BL_COMMAND_OP_STROKE_PATH:
+				result = blContextStrokePathD(self, reinterpret_cast<const BLPathCore*>(&objects[*reinterpret_cast<const uint32_t*>(payload)]));
+				break;
+
+			case BL_COMMAND_OP_FILL_TEXT:
+			case BL_COMMAND_OP_STROKE_TEXT:
+			{
+				auto text = reinterpret_cast<const BLCommandText*>(payload);
+				auto font = reinterpret_cast<const BLFontCore*>(&objects[text->font]);
+
+				if (header->op == BL_COMMAND_OP_FILL_TEXT)
+				{
+					result = blContextFillTextD(self, &text->origin, font, text + 1, text->size, BL_TEXT_ENCODING_UTF16);
+				}
+				else
+				{
+					result = blContextStrokeTextD(self, &text->origin, font, text + 1, text->size, BL_TEXT_ENCODING_UTF16);
+				}
+				break;
+			}
+
+			case BL_COMMAND_OP_BLIT_IMAGE:
+			case BL_COMMAND_OP_BLIT_SCALED_IMAGE:
+			{
+				auto blit = reinterpret_cast<const BLCommandBlit*>(payload);
+				auto image = reinterpret_cast<const BLImageCore*>(&objects[blit->image]);
+				auto area = blit->hasArea ? &blit->area : nullptr;
+
+				if (header->op == BL_COMMAND_OP_BLIT_IMAGE)
+				{
+					::BLPoint dst(blit->dst.x, blit->dst.y);
+					result = blContextBlitImageD(self, &dst, image, area);
+				}
+				else
+				{
+					result = blContextBlitScaledImageD(self, &blit->dst, image, area);
+				}
+				break;
+			}
+
+			default:
+				result = BL_ERROR_INVALID_STATE;
+				break;
+			}
+
+			if (result != BL_SUCCESS)
+			{
+				return result;
+			}
+
+			ptr = payload + header->size;
+		}
+
+		return BL_SUCCESS;
+	}
+}
+
+#pragma managed(pop)
\ No newline at end of file
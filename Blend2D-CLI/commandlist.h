@@ -0,0 +1,870 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "context.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+
+namespace Blend2D
+{
+	//! Recorded command operation (native).
+	enum BLCommandOp : uint32_t
+	{
+		BL_COMMAND_OP_SAVE = 0,
+		BL_COMMAND_OP_RESTORE,
+		BL_COMMAND_OP_MATRIX_OP,
+		BL_COMMAND_OP_USER_TO_META,
+		BL_COMMAND_OP_CLIP_TO_RECT,
+		BL_COMMAND_OP_RESTORE_CLIPPING,
+		BL_COMMAND_OP_CLEAR_ALL,
+		BL_COMMAND_OP_CLEAR_RECT,
+		BL_COMMAND_OP_SET_COMP_OP,
+		BL_COMMAND_OP_SET_GLOBAL_ALPHA,
+		BL_COMMAND_OP_SET_FILL_ALPHA,
+		BL_COMMAND_OP_SET_FILL_RULE,
+		BL_COMMAND_OP_SET_FILL_STYLE_RGBA32,
+		BL_COMMAND_OP_SET_FILL_STYLE_RGBA64,
+		BL_COMMAND_OP_SET_FILL_STYLE_OBJECT,
+		BL_COMMAND_OP_SET_STROKE_ALPHA,
+		BL_COMMAND_OP_SET_STROKE_STYLE_RGBA32,
+		BL_COMMAND_OP_SET_STROKE_STYLE_RGBA64,
+		BL_COMMAND_OP_SET_STROKE_STYLE_OBJECT,
+		BL_COMMAND_OP_SET_STROKE_WIDTH,
+		BL_COMMAND_OP_SET_STROKE_MITER_LIMIT,
+		BL_COMMAND_OP_SET_STROKE_JOIN,
+		BL_COMMAND_OP_SET_STROKE_CAPS,
+		BL_COMMAND_OP_FILL_ALL,
+		BL_COMMAND_OP_FILL_GEOMETRY,
+		BL_COMMAND_OP_FILL_PATH,
+		BL_COMMAND_OP_FILL_TEXT,
+		BL_COMMAND_OP_STROKE_GEOMETRY,
+		BL_COMMAND_OP_STROKE_PATH,
+		BL_COMMAND_OP_STROKE_TEXT,
+		BL_COMMAND_OP_BLIT_IMAGE,
+		BL_COMMAND_OP_BLIT_SCALED_IMAGE,
+	};
+
+	//! Header of a recorded command, followed by `size` bytes of payload.
+	struct BLCommandHeader
+	{
+		uint32_t op;
+		uint32_t size;
+	};
+
+	//! Payload of FILL_GEOMETRY and STROKE_GEOMETRY, followed by the geometry data.
+	//!
+	//! Array geometries (polygons, polylines, box/rect arrays) are stored as an
+	//! item count followed by the items, the array view is rebuilt on replay.
+	struct BLCommandGeometry
+	{
+		uint32_t geometryType;
+		uint32_t reserved;
+	};
+
+	//! Payload of FILL_TEXT and STROKE_TEXT, followed by `size` UTF-16 code units.
+	struct BLCommandText
+	{
+		::BLPoint origin;
+		uint32_t font;
+		uint32_t size;
+	};
+
+	//! Payload of BLIT_IMAGE and BLIT_SCALED_IMAGE.
+	struct BLCommandBlit
+	{
+		::BLRect dst;
+		::BLRectI area;
+		uint32_t image;
+		uint32_t hasArea;
+	};
+
+	//! Payload of MATRIX_OP.
+	struct BLCommandMatrixOp
+	{
+		uint32_t opType;
+		uint32_t reserved;
+		double data[6];
+	};
+
+	//! Native storage of a `BLCommandList`.
+	//!
+	//! Commands are packed into a single growable buffer (8-byte aligned) and
+	//! objects referenced by commands (paths, images, fonts, gradients and
+	//! patterns) are retained as weak references so they outlive the managed
+	//! wrappers that recorded them.
+	struct BLCommandBuffer
+	{
+		uint8_t* data = nullptr;
+		size_t size = 0;
+		size_t capacity = 0;
+		size_t commandCount = 0;
+
+		BLVariantCore* objects = nullptr;
+		size_t objectCount = 0;
+		size_t objectCapacity = 0;
+
+		~BLCommandBuffer()
+		{
+			Clear();
+
+			free(data);
+			free(objects);
+		}
+
+		void Clear()
+		{
+			for (size_t i = 0; i < objectCount; i++)
+			{
+				blVariantDestroy(&objects[i]);
+			}
+
+			size = 0;
+			commandCount = 0;
+			objectCount = 0;
+		}
+
+		uint8_t* Append(uint32_t op, size_t payloadSize)
+		{
+			size_t alignedSize = (payloadSize + 7) & ~size_t(7);
+			size_t required = size + sizeof(BLCommandHeader) + alignedSize;
+
+			if (required > capacity && !Grow(required))
+			{
+				return nullptr;
+			}
+
+			auto header = reinterpret_cast<BLCommandHeader*>(data + size);
+			header->op = op;
+			header->size = (uint32_t)alignedSize;
+
+			size = required;
+			commandCount++;
+
+			return reinterpret_cast<uint8_t*>(header + 1);
+		}
+
+		bool AddObject(const void* object, uint32_t* indexOut)
+		{
+			auto core = static_cast<const BLVariantCore*>(object);
+
+			// Consecutive commands usually share the same path, image or font.
+			if (objectCount > 0 && objects[objectCount - 1].impl == core->impl)
+			{
+				*indexOut = (uint32_t)(objectCount - 1);
+				return true;
+			}
+
+			if (objectCount == objectCapacity)
+			{
+				size_t newCapacity = objectCapacity < 64 ? 64 : objectCapacity * 2;
+				auto newObjects = static_cast<BLVariantCore*>(realloc(objects, newCapacity * sizeof(BLVariantCore)));
+
+				if (newObjects == nullptr)
+				{
+					return false;
+				}
+
+				objects = newObjects;
+				objectCapacity = newCapacity;
+			}
+
+			blVariantInitWeak(&objects[objectCount], core);
+
+			*indexOut = (uint32_t)objectCount++;
+			return true;
+		}
+
+	private:
+
+		bool Grow(size_t required)
+		{
+			size_t newCapacity = capacity < 4096 ? 4096 : capacity * 2;
+
+			while (newCapacity < required)
+			{
+				newCapacity *= 2;
+			}
+
+			auto newData = static_cast<uint8_t*>(realloc(data, newCapacity));
+
+			if (newData == nullptr)
+			{
+				return false;
+			}
+
+			data = newData;
+			capacity = newCapacity;
+			return true;
+		}
+	};
+
+	//! Replays all commands of `buffer` on `self`, stops at the first failure.
+	extern BLResult ReplayCommands(BLContextCore* self, const BLCommandBuffer* buffer);
+
+	public ref class BLCommandList sealed : public BLObject
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<BLCommandBuffer> buffer;
+
+	public:
+
+		BLCommandList()
+			: BLObject()
+		{
+		}
+
+	public:
+
+		void Clear()
+		{
+			buffer->Clear();
+		}
+
+		void Replay(BLContext^ context)
+		{
+			if (context == nullptr)
+			{
+				throw gcnew ArgumentNullException("context");
+			}
+
+			context->InvalidateStyleState();
+			context->CheckResult(ReplayCommands(context, buffer));
+		}
+
+	public:
+
+		// State Management
+
+		void Save()
+		{
+			Record(BL_COMMAND_OP_SAVE, 0);
+		}
+
+		void Restore()
+		{
+			Record(BL_COMMAND_OP_RESTORE, 0);
+		}
+
+		void ClipToRect(BLRect rect)
+		{
+			RecordValue(BL_COMMAND_OP_CLIP_TO_RECT, rect);
+		}
+
+		void ClipToRect(double x, double y, double w, double h)
+		{
+			ClipToRect(BLRect(x, y, w, h));
+		}
+
+		void RestoreClipping()
+		{
+			Record(BL_COMMAND_OP_RESTORE_CLIPPING, 0);
+		}
+
+		void ClearAll()
+		{
+			Record(BL_COMMAND_OP_CLEAR_ALL, 0);
+		}
+
+		void ClearRect(BLRect rect)
+		{
+			RecordValue(BL_COMMAND_OP_CLEAR_RECT, rect);
+		}
+
+		void ClearRect(double x, double y, double w, double h)
+		{
+			ClearRect(BLRect(x, y, w, h));
+		}
+
+		void SetCompOp(BLCompOp compOp)
+		{
+			RecordValue(BL_COMMAND_OP_SET_COMP_OP, (uint32_t)compOp);
+		}
+
+		void SetGlobalAlpha(double alpha)
+		{
+			RecordValue(BL_COMMAND_OP_SET_GLOBAL_ALPHA, alpha);
+		}
+
+		void SetFillRule(BLFillRule fillRule)
+		{
+			RecordValue(BL_COMMAND_OP_SET_FILL_RULE, (uint32_t)fillRule);
+		}
+
+	public:
+
+		// Fill Style & Options
+
+		void SetFillStyle(BLRgba32 rgba32)
+		{
+			RecordValue(BL_COMMAND_OP_SET_FILL_STYLE_RGBA32, rgba32.value);
+		}
+
+		void SetFillStyle(BLRgba64 rgba64)
+		{
+			RecordValue(BL_COMMAND_OP_SET_FILL_STYLE_RGBA64, rgba64.value);
+		}
+
+		void SetFillStyle(BLGradient^ gradient)
+		{
+			RecordObject(BL_COMMAND_OP_SET_FILL_STYLE_OBJECT, gradient);
+		}
+
+		void SetFillStyle(BLPattern^ pattern)
+		{
+			RecordObject(BL_COMMAND_OP_SET_FILL_STYLE_OBJECT, pattern);
+		}
+
+		void SetFillAlpha(double alpha)
+		{
+			RecordValue(BL_COMMAND_OP_SET_FILL_ALPHA, alpha);
+		}
+
+	public:
+
+		// Stroke Style & Options
+
+		void SetStrokeStyle(BLRgba32 rgba32)
+		{
+			RecordValue(BL_COMMAND_OP_SET_STROKE_STYLE_RGBA32, rgba32.value);
+		}
+
+		void SetStrokeStyle(BLRgba64 rgba64)
+		{
+			RecordValue(BL_COMMAND_OP_SET_STROKE_STYLE_RGBA64, rgba64.value);
+		}
+
+		void SetStrokeStyle(BLGradient^ gradient)
+		{
+			RecordObject(BL_COMMAND_OP_SET_STROKE_STYLE_OBJECT, gradient);
+		}
+
+		void SetStrokeStyle(BLPattern^ pattern)
+		{
+			RecordObject(BL_COMMAND_OP_SET_STROKE_STYLE_OBJECT, pattern);
+		}
+
+		void SetStrokeAlpha(double alpha)
+		{
+			RecordValue(BL_COMMAND_OP_SET_STROKE_ALPHA, alpha);
+		}
+
+		void SetStrokeWidth(double width)
+		{
+			RecordValue(BL_COMMAND_OP_SET_STROKE_WIDTH, width);
+		}
+
+		void SetStrokeMiterLimit(double miterLimit)
+		{
+			RecordValue(BL_COMMAND_OP_SET_STROKE_MITER_LIMIT, miterLimit);
+		}
+
+		void SetStrokeJoin(BLStrokeJoin strokeJoin)
+		{
+			RecordValue(BL_COMMAND_OP_SET_STROKE_JOIN, (uint32_t)strokeJoin);
+		}
+
+		void SetStrokeCaps(BLStrokeCap strokeCap)
+		{
+			RecordValue(BL_COMMAND_OP_SET_STROKE_CAPS, (uint32_t)strokeCap);
+		}
+
+	public:
+
+		// Fill Operations
+
+		void FillAll()
+		{
+			Record(BL_COMMAND_OP_FILL_ALL, 0);
+		}
+
+		void FillBox(BLBox box)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::Box, box);
+		}
+
+		void FillBox(double x0, double y0, double x1, double y1)
+		{
+			FillBox(BLBox(x0, y0, x1, y1));
+		}
+
+		void FillRect(BLRectI rect)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::RectI, rect);
+		}
+
+		void FillRect(BLRect rect)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::Rect, rect);
+		}
+
+		void FillRect(double x, double y, double w, double h)
+		{
+			FillRect(BLRect(x, y, w, h));
+		}
+
+		void FillCircle(BLCircle circle)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::Circle, circle);
+		}
+
+		void FillCircle(double cx, double cy, double r)
+		{
+			FillCircle(BLCircle(cx, cy, r));
+		}
+
+		void FillEllipse(BLEllipse ellipse)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::Ellipse, ellipse);
+		}
+
+		void FillEllipse(double cx, double cy, double rx, double ry)
+		{
+			FillEllipse(BLEllipse(cx, cy, rx, ry));
+		}
+
+		void FillRoundRect(BLRoundRect roundRect)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::RoundRect, roundRect);
+		}
+
+		void FillRoundRect(double x, double y, double w, double h, double r)
+		{
+			FillRoundRect(BLRoundRect(x, y, w, h, r));
+		}
+
+		void FillChord(BLArc chord)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::Chord, chord);
+		}
+
+		void FillPie(BLArc pie)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::Pie, pie);
+		}
+
+		void FillTriangle(BLTriangle triangle)
+		{
+			RecordGeometry(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::Triangle, triangle);
+		}
+
+		void FillTriangle(double x0, double y0, double x1, double y1, double x2, double y2)
+		{
+			FillTriangle(BLTriangle(x0, y0, x1, y1, x2, y2));
+		}
+
+		void FillPolygon(array<BLPoint>^ poly)
+		{
+			RecordArray(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::Polygon, poly);
+		}
+
+		void FillBoxArray(array<BLBox>^ array)
+		{
+			RecordArray(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::BoxArray, array);
+		}
+
+		void FillRectArray(array<BLRect>^ array)
+		{
+			RecordArray(BL_COMMAND_OP_FILL_GEOMETRY, BLGeometryType::RectArray, array);
+		}
+
+		void FillPath(BLPath^ path)
+		{
+			RecordObject(BL_COMMAND_OP_FILL_PATH, path);
+		}
+
+		void FillText(BLPoint dst, BLFont^ font, String^ text)
+		{
+			RecordText(BL_COMMAND_OP_FILL_TEXT, dst, font, text);
+		}
+
+	public:
+
+		// Stroke Operations
+
+		void StrokeBox(BLBox box)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::Box, box);
+		}
+
+		void StrokeRect(BLRectI rect)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::RectI, rect);
+		}
+
+		void StrokeRect(BLRect rect)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::Rect, rect);
+		}
+
+		void StrokeRect(double x, double y, double w, double h)
+		{
+			StrokeRect(BLRect(x, y, w, h));
+		}
+
+		void StrokeLine(BLLine line)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::Line, line);
+		}
+
+		void StrokeLine(double x0, double y0, double x1, double y1)
+		{
+			StrokeLine(BLLine(x0, y0, x1, y1));
+		}
+
+		void StrokeCircle(BLCircle circle)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::Circle, circle);
+		}
+
+		void StrokeCircle(double cx, double cy, double r)
+		{
+			StrokeCircle(BLCircle(cx, cy, r));
+		}
+
+		void StrokeEllipse(BLEllipse ellipse)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::Ellipse, ellipse);
+		}
+
+		void StrokeRoundRect(BLRoundRect roundRect)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::RoundRect, roundRect);
+		}
+
+		void StrokeArc(BLArc arc)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::Arc, arc);
+		}
+
+		void StrokeTriangle(BLTriangle triangle)
+		{
+			RecordGeometry(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::Triangle, triangle);
+		}
+
+		void StrokePolyline(array<BLPoint>^ poly)
+		{
+			RecordArray(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::PolyLine, poly);
+		}
+
+		void StrokePolygon(array<BLPoint>^ poly)
+		{
+			RecordArray(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::Polygon, poly);
+		}
+
+		void StrokeRectArray(array<BLRect>^ array)
+		{
+			RecordArray(BL_COMMAND_OP_STROKE_GEOMETRY, BLGeometryType::RectArray, array);
+		}
+
+		void StrokePath(BLPath^ path)
+		{
+			RecordObject(BL_COMMAND_OP_STROKE_PATH, path);
+		}
+
+		void StrokeText(BLPoint dst, BLFont^ font, String^ text)
+		{
+			RecordText(BL_COMMAND_OP_STROKE_TEXT, dst, font, text);
+		}
+
+	public:
+
+		// Blit Operations
+
+		void BlitImage(BLPoint dst, BLImage^ image)
+		{
+			RecordBlit(BL_COMMAND_OP_BLIT_IMAGE, BLRect(dst.X, dst.Y, 0, 0), image, BLRectI(), false);
+		}
+
+		void BlitImage(BLPoint dst, BLImage^ image, BLRectI area)
+		{
+			RecordBlit(BL_COMMAND_OP_BLIT_IMAGE, BLRect(dst.X, dst.Y, 0, 0), image, area, true);
+		}
+
+		void BlitImage(BLRect dst, BLImage^ image)
+		{
+			RecordBlit(BL_COMMAND_OP_BLIT_SCALED_IMAGE, dst, image, BLRectI(), false);
+		}
+
+		void BlitImage(BLRect dst, BLImage^ image, BLRectI area)
+		{
+			RecordBlit(BL_COMMAND_OP_BLIT_SCALED_IMAGE, dst, image, area, true);
+		}
+
+	public:
+
+		// Transformations
+
+		void UserToMeta()
+		{
+			Record(BL_COMMAND_OP_USER_TO_META, 0);
+		}
+
+		void ResetMatrix()
+		{
+			RecordMatrixOp(BLMatrix2DOp::Reset, 0, 0, 0);
+		}
+
+		void Translate(double x, double y)
+		{
+			RecordMatrixOp(BLMatrix2DOp::Translate, x, y, 0);
+		}
+
+		void Translate(BLPoint p)
+		{
+			RecordMatrixOp(BLMatrix2DOp::Translate, p.X, p.Y, 0);
+		}
+
+		void Scale(double xy)
+		{
+			RecordMatrixOp(BLMatrix2DOp::Scale, xy, xy, 0);
+		}
+
+		void Scale(double x, double y)
+		{
+			RecordMatrixOp(BLMatrix2DOp::Scale, x, y, 0);
+		}
+
+		void Skew(double x, double y)
+		{
+			RecordMatrixOp(BLMatrix2DOp::Skew, x, y, 0);
+		}
+
+		void Rotate(double angle)
+		{
+			RecordMatrixOp(BLMatrix2DOp::Rotate, angle, 0, 0);
+		}
+
+		void Rotate(double angle, double x, double y)
+		{
+			RecordMatrixOp(BLMatrix2DOp::RotatePoint, angle, x, y);
+		}
+
+		void Transform(BLMatrix2D m)
+		{
+			RecordMatrix(BLMatrix2DOp::Transform, m);
+		}
+
+		void PostTranslate(double x, double y)
+		{
+			RecordMatrixOp(BLMatrix2DOp::PostTranslate, x, y, 0);
+		}
+
+		void PostScale(double x, double y)
+		{
+			RecordMatrixOp(BLMatrix2DOp::PostScale, x, y, 0);
+		}
+
+		void PostRotate(double angle)
+		{
+			RecordMatrixOp(BLMatrix2DOp::PostRotate, angle, 0, 0);
+		}
+
+		void PostTransform(BLMatrix2D m)
+		{
+			RecordMatrix(BLMatrix2DOp::PostTransform, m);
+		}
+
+		void SetUserMatrix(BLMatrix2D m)
+		{
+			RecordMatrix(BLMatrix2DOp::Assign, m);
+		}
+
+	private:
+
+		uint8_t* Record(BLCommandOp op, size_t payloadSize)
+		{
+			auto payload = buffer->Append(op, payloadSize);
+
+			if (payload == nullptr)
+			{
+				CheckResult(BL_ERROR_OUT_OF_MEMORY);
+			}
+
+			return payload;
+		}
+
+		void RecordValue(BLCommandOp op, uint32_t value)
+		{
+			*reinterpret_cast<uint32_t*>(Record(op, sizeof(uint32_t))) = value;
+		}
+
+		void RecordValue(BLCommandOp op, uint64_t value)
+		{
+			*reinterpret_cast<uint64_t*>(Record(op, sizeof(uint64_t))) = value;
+		}
+
+		void RecordValue(BLCommandOp op, double value)
+		{
+			*reinterpret_cast<double*>(Record(op, sizeof(double))) = value;
+		}
+
+		void RecordValue(BLCommandOp op, BLRect rect)
+		{
+			Pin(BLRect, pRect, rect);
+
+			memcpy(Record(op, sizeof(::BLRect)), pRect, sizeof(::BLRect));
+		}
+
+		template<typename T>
+		void RecordObject(BLCommandOp op, T^ object)
+		{
+			*reinterpret_cast<uint32_t*>(Record(op, sizeof(uint32_t))) = AddObject(object);
+		}
+
+		template<typename T>
+		void RecordGeometry(BLCommandOp op, BLGeometryType geometryType, T geometry)
+		{
+			Pin(T, pGeometry, geometry);
+
+			auto payload = Record(op, sizeof(BLCommandGeometry) + sizeof(T));
+			auto header = reinterpret_cast<BLCommandGeometry*>(payload);
+
+			header->geometryType = (uint32_t)geometryType;
+			header->reserved = 0;
+
+			memcpy(header + 1, pGeometry, sizeof(T));
+		}
+
+		template<typename T>
+		void RecordArray(BLCommandOp op, BLGeometryType geometryType, array<T>^ items)
+		{
+			if (items->Length > 0)
+			{
+				Pin(T, pItems, items[0]);
+
+				size_t itemsSize = items->Length * sizeof(T);
+
+				auto payload = Record(op, sizeof(BLCommandGeometry) + sizeof(uint64_t) + itemsSize);
+				auto header = reinterpret_cast<BLCommandGeometry*>(payload);
+				auto count = reinterpret_cast<uint64_t*>(header + 1);
+
+				header->geometryType = (uint32_t)geometryType;
+				header->reserved = 0;
+				*count = (uint64_t)items->Length;
+
+				memcpy(count + 1, pItems, itemsSize);
+			}
+		}
+
+		void RecordText(BLCommandOp op, BLPoint dst, BLFont^ font, String^ text)
+		{
+			if (text->Length > 0)
+			{
+				ConvertWchar(str, text);
+
+				size_t textSize = text->Length * sizeof(wchar_t);
+				uint32_t fontIndex = AddObject(font);
+
+				auto payload = reinterpret_cast<BLCommandText*>(Record(op, sizeof(BLCommandText) + textSize));
+
+				payload->origin.x = dst.X;
+				payload->origin.y = dst.Y;
+				payload->font = fontIndex;
+				payload->size = (uint32_t)text->Length;
+
+				memcpy(payload + 1, str, textSize);
+			}
+		}
+
+		void RecordBlit(BLCommandOp op, BLRect dst, BLImage^ image, BLRectI area, bool hasArea)
+		{
+			uint32_t imageIndex = AddObject(image);
+
+			auto payload = reinterpret_cast<BLCommandBlit*>(Record(op, sizeof(BLCommandBlit)));
+
+			payload->dst.x = dst.X;
+			payload->dst.y = dst.Y;
+			payload->dst.w = dst.Width;
+			payload->dst.h = dst.Height;
+			payload->image = imageIndex;
+			payload->area.x = area.X;
+			payload->area.y = area.Y;
+			payload->area.w = area.Width;
+			payload->area.h = area.Height;
+			payload->hasArea = hasArea;
+		}
+
+		void RecordMatrixOp(BLMatrix2DOp opType, double v1, double v2, double v3)
+		{
+			auto payload = reinterpret_cast<BLCommandMatrixOp*>(Record(BL_COMMAND_OP_MATRIX_OP, sizeof(BLCommandMatrixOp)));
+
+			payload->opType = (uint32_t)opType;
+			payload->reserved = 0;
+			payload->data[0] = v1;
+			payload->data[1] = v2;
+			payload->data[2] = v3;
+		}
+
+		void RecordMatrix(BLMatrix2DOp opType, BLMatrix2D m)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			auto payload = reinterpret_cast<BLCommandMatrixOp*>(Record(BL_COMMAND_OP_MATRIX_OP, sizeof(BLCommandMatrixOp)));
+
+			payload->opType = (uint32_t)opType;
+			payload->reserved = 0;
+
+			memcpy(payload->data, pMatrix, sizeof(payload->data));
+		}
+
+		// The handle is checked before it is converted, the conversion itself
+		// would fail on a null handle with a NullReferenceException.
+		template<typename T>
+		uint32_t AddObject(T^ object)
+		{
+			uint32_t index = 0;
+
+			if (object == nullptr)
+			{
+				throw gcnew ArgumentNullException("object");
+			}
+
+			const void* core = object;
+
+			if (!buffer->AddObject(core, &index))
+			{
+				CheckResult(BL_ERROR_OUT_OF_MEMORY);
+			}
+
+			return index;
+		}
+
+	public:
+
+		property bool IsEmpty
+		{
+			bool get()
+			{
+				return buffer->commandCount == 0;
+			}
+		}
+
+		property size_t CommandCount
+		{
+			size_t get()
+			{
+				return buffer->commandCount;
+			}
+		}
+
+		property size_t Size
+		{
+			size_t get()
+			{
+				return buffer->size;
+			}
+		}
+
+		property size_t Capacity
+		{
+			size_t get()
+			{
+				return buffer->capacity;
+			}
+		}
+	};
+}
\ No newline at end of file
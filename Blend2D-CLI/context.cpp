@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "api.h"
+#include "context.h"
+
+// Batched blits and instanced fills run in native code so a whole batch costs
+// a single managed/native transition instead of one per item.
+#pragma managed(push, off)
+
+namespace Blend2D
+{
+	BLResult BlitImageBatch(BLContextCore* self, const BLImageCore* image, const BLBlitItemData* items, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			const auto& item = items[i];
+			BLResult result;
+
+			if (item.scaled)
+			{
+				result = blContextBlitScaledImageD(self, &item.dst, image, &item.area);
+			}
+			else
+			{
+				::BLPoint dst(item.dst.x, item.dst.y);
+				result = blContextBlitImageD(self, &dst, image, &item.area);
+			}
+
+			if (result != BL_SUCCESS)
+			{
+				return result;
+			}
+		}
+
+		return BL_SUCCESS;
+	}
+
+	BLResult FillPathInstances(BLContextCore* self, const BLPathCore* path, const ::BLPoint* offsets, const ::BLMatrix2D* matrices, const uint32_t* colors, size_t count)
+	{
+		const ::BLMatrix2D base = static_cast<const ::BLContext*>(self)->userMatrix();
+
+		BLResult result = BL_SUCCESS;
+		uint32_t color = 0;
+
+		for (size_t i = 0; i < count && result == BL_SUCCESS; i++)
+		{
+			::BLMatrix2D m = base;
+
+			if (offsets)
+			{
+				m.translate(offsets[i].x, offsets[i].y);
+			}
+
+			if (matrices)
+			{
+				m.transform(matrices[i]);
+			}
+
+			result = blContextMatrixOp(self, BL_MATRIX2D_OP_ASSIGN, &m);
+
+			// Consecutive instances of the same color keep the fill style.
+			if (result == BL_SUCCESS && colors && (i == 0 || colors[i] != color))
+			{
+				color = colors[i];
+				result = blContextSetFillStyleRgba32(self, color);
+			}
+
+			if (result == BL_SUCCESS)
+			{
+				result = blContextFillPathD(self, path);
+			}
+		}
+
+		BLResult restoreResult = blContextMatrixOp(self, BL_MATRIX2D_OP_ASSIGN, &base);
+
+		return result != BL_SUCCESS ? result : restoreResult;
+	}
+}
+
+#pragma managed(pop)
@@ -11,10 +11,16 @@
 #include "image.h"
 #include "path.h"
 #include "font.h"
+#include "textcache.h"
+#include "region.h"
+#include "surface.h"
+#include "swapchain.h"
 #include "control.h"
 
 using namespace System;
 using namespace System::Diagnostics;
+using namespace System::Threading;
+using namespace System::Threading::Tasks;
 
 #define ContextCreateInfo(source) (::BLContextCreateInfo*)(source)
 #define ContextCookie(source) (::BLContextCookie*)(source)
@@ -95,6 +101,34 @@ namespace Blend2D
 		Exclusion = BL_COMP_OP_EXCLUSION,
 	};
 
+	//! Rendering context create-flags.
+	[FlagsAttribute]
+	public enum class BLContextCreateFlags : UInt32
+	{
+		//! No flags.
+		None = 0,
+		//! Fallback to synchronous rendering if no worker threads can be acquired.
+		FallbackToSync = BL_CONTEXT_CREATE_FLAG_FALLBACK_TO_SYNC,
+		//! Use an isolated thread-pool (testing, debugging and benchmarking only).
+		IsolatedThreadPool = BL_CONTEXT_CREATE_FLAG_ISOLATED_THREAD_POOL,
+		//! Use an isolated JIT runtime (testing, debugging and benchmarking only).
+		IsolatedJitRuntime = BL_CONTEXT_CREATE_FLAG_ISOLATED_JIT_RUNTIME,
+		//! Enable logging of the isolated JIT runtime to stderr.
+		IsolatedJitLogging = BL_CONTEXT_CREATE_FLAG_ISOLATED_JIT_LOGGING,
+		//! Override CPU features with `BLContextCreateInfo::CpuFeatures`.
+		OverrideCpuFeatures = BL_CONTEXT_CREATE_FLAG_OVERRIDE_CPU_FEATURES,
+	};
+
+	//! Rendering context flush-flags.
+	[FlagsAttribute]
+	public enum class BLContextFlushFlags : UInt32
+	{
+		//! Flush the command queue without waiting.
+		None = 0,
+		//! Flush the command queue and wait for its completion (will block).
+		Sync = BL_CONTEXT_FLUSH_SYNC,
+	};
+
 	public value struct BLContextCreateInfo sealed
 	{
 	private:
@@ -150,6 +184,42 @@ namespace Blend2D
 				threadCount = value;
 			}
 		}
+
+		property BLContextCreateFlags Flags
+		{
+			BLContextCreateFlags get()
+			{
+				return (BLContextCreateFlags)flags;
+			}
+			void set(BLContextCreateFlags value)
+			{
+				flags = (uint32_t)value;
+			}
+		}
+
+		property int CommandQueueLimit
+		{
+			int get()
+			{
+				return commandQueueLimit;
+			}
+			void set(int value)
+			{
+				commandQueueLimit = value;
+			}
+		}
+
+		property uint32_t CpuFeatures
+		{
+			uint32_t get()
+			{
+				return cpuFeatures;
+			}
+			void set(uint32_t value)
+			{
+				cpuFeatures = value;
+			}
+		}
 	};
 
 	public value struct BLContextCookie sealed
@@ -181,12 +251,92 @@ namespace Blend2D
 		}
 	};
 
+	//! Blit item (native), must match the layout of `BLBlitItem`.
+	struct BLBlitItemData
+	{
+		::BLRect dst;
+		::BLRectI area;
+		uint32_t scaled;
+		uint32_t reserved;
+	};
+
+	extern BLResult BlitImageBatch(BLContextCore* self, const BLImageCore* image, const BLBlitItemData* items, size_t count);
+	extern BLResult FillPathInstances(BLContextCore* self, const BLPathCore* path, const ::BLPoint* offsets, const ::BLMatrix2D* matrices, const uint32_t* colors, size_t count);
+
+	public value struct BLBlitItem sealed
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLRect dst;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLRectI area;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint32_t scaled;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint32_t reserved;
+
+	public:
+
+		BLBlitItem(BLPoint dst, BLRectI area)
+			: dst(BLRect(dst.X, dst.Y, area.Width, area.Height)), area(area), scaled(0), reserved(0)
+		{
+		}
+
+		BLBlitItem(BLRect dst, BLRectI area)
+			: dst(dst), area(area), scaled(1), reserved(0)
+		{
+		}
+
+	public:
+
+		String^ ToString() override
+		{
+			return String::Format("Destination={0}, Area={1}, Scaled={2}", dst, area, IsScaled);
+		}
+
+	public:
+
+		property BLRect Destination
+		{
+			BLRect get()
+			{
+				return dst;
+			}
+		}
+
+		property BLRectI Area
+		{
+			BLRectI get()
+			{
+				return area;
+			}
+		}
+
+		property bool IsScaled
+		{
+			bool get()
+			{
+				return scaled != 0;
+			}
+		}
+	};
+
 	public ref class BLContext sealed : public BLObject
 	{
 	private:
 
 		typedef ::BLContext ImplType;
 
+		// Kinds of fill/stroke style remembered by the style shadow.
+		literal uint32_t StyleUnknown = 0;
+		literal uint32_t StyleRgba32 = 1;
+		literal uint32_t StyleRgba64 = 2;
+		literal uint32_t StyleObject = 3;
+
 	private:
 
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
@@ -195,6 +345,33 @@ namespace Blend2D
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
 		BLImage^ targetImage = nullptr;
 
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLErrorMode errorMode = BLErrorMode::Throw;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLResultCode accumulatedError = BLResultCode::BL_SUCCESS;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		size_t accumulatedErrorCount = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint32_t fillStyleKind = StyleUnknown;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t fillStyleValue = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint32_t strokeStyleKind = StyleUnknown;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t strokeStyleValue = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t stateChangesIssued = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t stateChangesSkipped = 0;
+
 
 	public:
 
@@ -233,6 +410,14 @@ namespace Blend2D
 			return impl;
 		}
 
+	internal:
+
+		void InvalidateStyleState()
+		{
+			fillStyleKind = StyleUnknown;
+			strokeStyleKind = StyleUnknown;
+		}
+
 	protected:
 
 		void Destroy() override
@@ -247,6 +432,8 @@ namespace Blend2D
 		void Begin(BLImage^ image)
 		{
 			targetImage = image;
+			ResetErrors();
+			InvalidateStyleState();
 	
 			CheckResult(blContextBegin(this, image, nullptr));
 		}
@@ -254,6 +441,8 @@ namespace Blend2D
 		void Begin(BLImage^ image, BLContextCreateInfo createInfo)
 		{
 			targetImage = image;
+			ResetErrors();
+			InvalidateStyleState();
 
 			Pin(BLContextCreateInfo, pCreateInfo, createInfo);
 
@@ -262,11 +451,47 @@ namespace Blend2D
 
 		void End()
 		{
+			InvalidateStyleState();
+
 			CheckResult(blContextEnd(this));
 
 			targetImage = nullptr;
 		}
 
+		void Flush(BLContextFlushFlags flags)
+		{
+			CheckResult(blContextFlush(this, (uint32_t)flags));
+		}
+
+		// The asynchronous flushes wait for the worker threads on a thread-pool
+		// thread. The context must not be used until the flush has completed.
+		Task^ FlushAsync()
+		{
+			return Task::Factory->StartNew(gcnew Action(this, &BLContext::FlushAndWait));
+		}
+
+		void FlushAsync(Action<BLResultCode>^ completed)
+		{
+			if (completed == nullptr)
+			{
+				throw gcnew ArgumentNullException("completed");
+			}
+
+			ThreadPool::QueueUserWorkItem(gcnew WaitCallback(this, &BLContext::FlushAndNotify), completed);
+		}
+
+		void ResetErrors()
+		{
+			accumulatedError = BLResultCode::BL_SUCCESS;
+			accumulatedErrorCount = 0;
+		}
+
+		void ResetStateCounters()
+		{
+			stateChangesIssued = 0;
+			stateChangesSkipped = 0;
+		}
+
 	public:
 
 		// State Management
@@ -285,6 +510,8 @@ namespace Blend2D
 		
 		void Restore()
 		{
+			InvalidateStyleState();
+
 			CheckResult(blContextRestore(this, nullptr));
 		}
 
@@ -292,6 +519,8 @@ namespace Blend2D
 		{
 			Pin(BLContextCookie, pCookie, cookie);
 
+			InvalidateStyleState();
+
 			CheckResult(blContextRestore(this, ContextCookie(pCookie)));
 		}
 
@@ -323,6 +552,31 @@ namespace Blend2D
 			ClipToRect(BLRect(x, y, w, h));
 		}
 
+		// Calls draw once per box of region with the clip reduced to that box,
+		// so only pixels inside the region are rasterized. Boxes are in the
+		// current user coordinates, the state is restored after every box.
+		void DrawClipped(BLRegion^ region, Action<BLContext^>^ draw)
+		{
+			auto count = region->Count;
+
+			for (int i = 0; i < count; i++)
+			{
+				auto box = region[i];
+
+				Save();
+
+				try
+				{
+					ClipToRect(BLRectI(box.X0, box.Y0, box.X1 - box.X0, box.Y1 - box.Y0));
+					draw(this);
+				}
+				finally
+				{
+					Restore();
+				}
+			}
+		}
+
 	public:
 
 		// Clear Operations
@@ -357,26 +611,52 @@ namespace Blend2D
 
 		void SetFillStyle(BLRgba32 rgba32)
 		{
-			CheckResult(blContextSetFillStyleRgba32(this, rgba32.value));
+			if (IsRedundant(fillStyleKind == StyleRgba32 && fillStyleValue == rgba32.value))
+			{
+				return;
+			}
+
+			TrackStyle(CheckResult(blContextSetFillStyleRgba32(this, rgba32.value)), fillStyleKind, fillStyleValue, StyleRgba32, rgba32.value);
 		}
 
 		void SetFillStyle(BLRgba64 rgba64)
 		{
-			CheckResult(blContextSetFillStyleRgba64(this, rgba64.value));
+			if (IsRedundant(fillStyleKind == StyleRgba64 && fillStyleValue == rgba64.value))
+			{
+				return;
+			}
+
+			TrackStyle(CheckResult(blContextSetFillStyleRgba64(this, rgba64.value)), fillStyleKind, fillStyleValue, StyleRgba64, rgba64.value);
 		}
 
 		void SetFillStyle(BLGradient^ gradient)
 		{
-			CheckResult(blContextSetFillStyleObject(this, gradient));
+			auto key = StyleKey(gradient);
+
+			if (IsRedundant(fillStyleKind == StyleObject && fillStyleValue == key))
+			{
+				return;
+			}
+
+			TrackStyle(CheckResult(blContextSetFillStyleObject(this, gradient)), fillStyleKind, fillStyleValue, StyleObject, key);
 		}
 
 		void SetFillStyle(BLPattern^ pattern)
 		{
-			CheckResult(blContextSetFillStyleObject(this, pattern));
+			auto key = StyleKey(pattern);
+
+			if (IsRedundant(fillStyleKind == StyleObject && fillStyleValue == key))
+			{
+				return;
+			}
+
+			TrackStyle(CheckResult(blContextSetFillStyleObject(this, pattern)), fillStyleKind, fillStyleValue, StyleObject, key);
 		}
 
 		void SetFillStyle(BLStyle^ style)
 		{
+			fillStyleKind = StyleUnknown;
+
 			CheckResult(blContextSetFillStyle(this, style));
 		}
 
@@ -386,26 +666,52 @@ namespace Blend2D
 
 		void SetStrokeStyle(BLRgba32 rgba32)
 		{
-			CheckResult(blContextSetStrokeStyleRgba32(this, rgba32.Value));
+			if (IsRedundant(strokeStyleKind == StyleRgba32 && strokeStyleValue == rgba32.Value))
+			{
+				return;
+			}
+
+			TrackStyle(CheckResult(blContextSetStrokeStyleRgba32(this, rgba32.Value)), strokeStyleKind, strokeStyleValue, StyleRgba32, rgba32.Value);
 		}
 
 		void SetStrokeStyle(BLRgba64 rgba64)
 		{
-			CheckResult(blContextSetStrokeStyleRgba64(this, rgba64.Value));
+			if (IsRedundant(strokeStyleKind == StyleRgba64 && strokeStyleValue == rgba64.Value))
+			{
+				return;
+			}
+
+			TrackStyle(CheckResult(blContextSetStrokeStyleRgba64(this, rgba64.Value)), strokeStyleKind, strokeStyleValue, StyleRgba64, rgba64.Value);
 		}
 
 		void SetStrokeStyle(BLGradient^ gradient)
 		{
-			CheckResult(blContextSetStrokeStyleObject(this, gradient));
+			auto key = StyleKey(gradient);
+
+			if (IsRedundant(strokeStyleKind == StyleObject && strokeStyleValue == key))
+			{
+				return;
+			}
+
+			TrackStyle(CheckResult(blContextSetStrokeStyleObject(this, gradient)), strokeStyleKind, strokeStyleValue, StyleObject, key);
 		}
 
 		void SetStrokeStyle(BLPattern^ pattern)
 		{
-			CheckResult(blContextSetStrokeStyleObject(this, pattern));
+			auto key = StyleKey(pattern);
+
+			if (IsRedundant(strokeStyleKind == StyleObject && strokeStyleValue == key))
+			{
+				return;
+			}
+
+			TrackStyle(CheckResult(blContextSetStrokeStyleObject(this, pattern)), strokeStyleKind, strokeStyleValue, StyleObject, key);
 		}
 
 		void SetStrokeStyle(BLStyle^ style)
 		{
+			strokeStyleKind = StyleUnknown;
+
 			CheckResult(blContextSetStrokeStyle(this, style));
 		}
 
@@ -559,65 +865,235 @@ namespace Blend2D
 			{
 				Pin(BLPointI, pPoly, poly[0]);
 
-				FillGeometry(BLGeometryType::PolygonI, pPoly);
+				FillGeometryArray(BLGeometryType::PolygonI, pPoly, poly->Length);
 			}
 		}
 
+		void FillPolygon(array<BLPointI>^ poly, int index, int count)
+		{
+			CheckArrayRange(poly, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLPointI, pPoly, poly[index]);
+
+				FillGeometryArray(BLGeometryType::PolygonI, pPoly, count);
+			}
+		}
+
+		void FillPolygon(const BLPointI* poly, size_t count)
+		{
+			FillGeometryArray(BLGeometryType::PolygonI, poly, count);
+		}
+
 		void FillPolygon(array<BLPoint>^ poly)
 		{
 			if (poly->Length > 0)
 			{
 				Pin(BLPoint, pPoly, poly[0]);
 
-				FillGeometry(BLGeometryType::Polygon, pPoly);
+				FillGeometryArray(BLGeometryType::Polygon, pPoly, poly->Length);
 			}
 		}
 
+		void FillPolygon(array<BLPoint>^ poly, int index, int count)
+		{
+			CheckArrayRange(poly, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLPoint, pPoly, poly[index]);
+
+				FillGeometryArray(BLGeometryType::Polygon, pPoly, count);
+			}
+		}
+
+		void FillPolygon(const BLPoint* poly, size_t count)
+		{
+			FillGeometryArray(BLGeometryType::Polygon, poly, count);
+		}
+
 		void FillBoxArray(array<BLBoxI>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLBoxI, pArray, array[0]);
 
-				FillGeometry(BLGeometryType::BoxIArray, pArray);
+				FillGeometryArray(BLGeometryType::BoxIArray, pArray, array->Length);
 			}
 		}
 
+		void FillBoxArray(array<BLBoxI>^ array, int index, int count)
+		{
+			CheckArrayRange(array, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLBoxI, pArray, array[index]);
+
+				FillGeometryArray(BLGeometryType::BoxIArray, pArray, count);
+			}
+		}
+
+		void FillBoxArray(const BLBoxI* array, size_t count)
+		{
+			FillGeometryArray(BLGeometryType::BoxIArray, array, count);
+		}
+
 		void FillBoxArray(array<BLBox>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLBox, pArray, array[0]);
 
-				FillGeometry(BLGeometryType::BoxArray, pArray);
+				FillGeometryArray(BLGeometryType::BoxArray, pArray, array->Length);
+			}
+		}
+
+		void FillBoxArray(array<BLBox>^ array, int index, int count)
+		{
+			CheckArrayRange(array, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLBox, pArray, array[index]);
+
+				FillGeometryArray(BLGeometryType::BoxArray, pArray, count);
 			}
 		}
 
+		void FillBoxArray(const BLBox* array, size_t count)
+		{
+			FillGeometryArray(BLGeometryType::BoxArray, array, count);
+		}
+
 		void FillRectArray(array<BLRectI>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLRectI, pArray, array[0]);
 
-				FillGeometry(BLGeometryType::RectIArray, pArray);
+				FillGeometryArray(BLGeometryType::RectIArray, pArray, array->Length);
+			}
+		}
+
+		void FillRectArray(array<BLRectI>^ array, int index, int count)
+		{
+			CheckArrayRange(array, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLRectI, pArray, array[index]);
+
+				FillGeometryArray(BLGeometryType::RectIArray, pArray, count);
 			}
 		}
 
+		void FillRectArray(const BLRectI* array, size_t count)
+		{
+			FillGeometryArray(BLGeometryType::RectIArray, array, count);
+		}
+
 		void FillRectArray(array<BLRect>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLRect, pArray, array[0]);
 
-				FillGeometry(BLGeometryType::RectArray, pArray);
+				FillGeometryArray(BLGeometryType::RectArray, pArray, array->Length);
+			}
+		}
+
+		void FillRectArray(array<BLRect>^ array, int index, int count)
+		{
+			CheckArrayRange(array, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLRect, pArray, array[index]);
+
+				FillGeometryArray(BLGeometryType::RectArray, pArray, count);
 			}
 		}
 
+		void FillRectArray(const BLRect* array, size_t count)
+		{
+			FillGeometryArray(BLGeometryType::RectArray, array, count);
+		}
+
 		void FillPath(BLPath^ path)
 		{
 			CheckResult(blContextFillPathD(this, path));
 		}
 
+		// Fills shape once per offset, translated in user coordinates. The
+		// loop runs in native code, the user matrix is restored afterwards.
+		void FillInstances(BLPath^ shape, array<BLPoint>^ offsets)
+		{
+			FillInstances(shape, offsets, 0, offsets != nullptr ? offsets->Length : 0);
+		}
+
+		void FillInstances(BLPath^ shape, array<BLPoint>^ offsets, int index, int count)
+		{
+			CheckArrayRange(offsets, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLPoint, pOffsets, offsets[index]);
+
+				FillInstances(shape, pOffsets, count);
+			}
+		}
+
+		void FillInstances(BLPath^ shape, const BLPoint* offsets, size_t count)
+		{
+			CheckResult(FillPathInstances(this, shape, Point(offsets), nullptr, nullptr, count));
+		}
+
+		// Fills shape once per matrix, applied on top of the user matrix. When
+		// colors is not null every instance is filled with its own color and
+		// the fill style is left at the color of the last instance.
+		void FillInstances(BLPath^ shape, array<BLMatrix2D>^ matrices, array<BLRgba32>^ colors)
+		{
+			FillInstances(shape, matrices, colors, 0, matrices != nullptr ? matrices->Length : 0);
+		}
+
+		void FillInstances(BLPath^ shape, array<BLMatrix2D>^ matrices, array<BLRgba32>^ colors, int index, int count)
+		{
+			CheckArrayRange(matrices, index, count);
+
+			if (colors != nullptr)
+			{
+				CheckArrayRange(colors, index, count);
+			}
+
+			if (count > 0)
+			{
+				Pin(BLMatrix2D, pMatrices, matrices[index]);
+
+				if (colors != nullptr)
+				{
+					Pin(BLRgba32, pColors, colors[index]);
+
+					FillInstances(shape, pMatrices, pColors, count);
+				}
+				else
+				{
+					FillInstances(shape, pMatrices, nullptr, count);
+				}
+			}
+		}
+
+		void FillInstances(BLPath^ shape, const BLMatrix2D* matrices, const BLRgba32* colors, size_t count)
+		{
+			if (colors != nullptr)
+			{
+				fillStyleKind = StyleUnknown;
+			}
+
+			CheckResult(FillPathInstances(this, shape, nullptr, Matrix2D(matrices), (const uint32_t*)colors, count));
+		}
+
 		void FillText(BLPointI dst, BLFont^ font, String^ text)
 		{
 			Pin(BLPointI, pDst, dst);
@@ -634,6 +1110,38 @@ namespace Blend2D
 			CheckResult(blContextFillTextD(this, Point(pDst), font, str, text->Length, (uint32_t)BLTextEncoding::UTF16));
 		}
 
+		// Shapes text through cache, repeated text is drawn as a cached glyph run.
+		void FillText(BLPointI dst, BLFont^ font, String^ text, BLTextRunCache^ cache)
+		{
+			if (cache == nullptr)
+			{
+				FillText(dst, font, text);
+				return;
+			}
+
+			auto glyphBuffer = cache->GetGlyphBuffer(font, text);
+
+			FillGlyphRun(dst, font, glyphBuffer->GlyphRun);
+
+			// The glyph run points into the buffer, keep it alive until drawn.
+			GC::KeepAlive(glyphBuffer);
+		}
+
+		void FillText(BLPoint dst, BLFont^ font, String^ text, BLTextRunCache^ cache)
+		{
+			if (cache == nullptr)
+			{
+				FillText(dst, font, text);
+				return;
+			}
+
+			auto glyphBuffer = cache->GetGlyphBuffer(font, text);
+
+			FillGlyphRun(dst, font, glyphBuffer->GlyphRun);
+
+			GC::KeepAlive(glyphBuffer);
+		}
+
 		void FillGlyphRun(BLPointI dst, BLFont^ font, BLGlyphRun glyphRun)
 		{
 			Pin(BLPointI, pDst, dst);
@@ -812,80 +1320,216 @@ namespace Blend2D
 			{
 				Pin(BLPointI, pPoly, poly[0]);
 
-				StrokeGeometry(BLGeometryType::PolyLineI, pPoly);
+				StrokeGeometryArray(BLGeometryType::PolyLineI, pPoly, poly->Length);
+			}
+		}
+
+		void StrokePolyline(array<BLPointI>^ poly, int index, int count)
+		{
+			CheckArrayRange(poly, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLPointI, pPoly, poly[index]);
+
+				StrokeGeometryArray(BLGeometryType::PolyLineI, pPoly, count);
 			}
 		}
 
+		void StrokePolyline(const BLPointI* poly, size_t count)
+		{
+			StrokeGeometryArray(BLGeometryType::PolyLineI, poly, count);
+		}
+
 		void StrokePolyline(array<BLPoint>^ poly)
 		{
 			if (poly->Length > 0)
 			{
 				Pin(BLPoint, pPoly, poly[0]);
 
-				StrokeGeometry(BLGeometryType::PolyLine, pPoly);
+				StrokeGeometryArray(BLGeometryType::PolyLine, pPoly, poly->Length);
+			}
+		}
+
+		void StrokePolyline(array<BLPoint>^ poly, int index, int count)
+		{
+			CheckArrayRange(poly, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLPoint, pPoly, poly[index]);
+
+				StrokeGeometryArray(BLGeometryType::PolyLine, pPoly, count);
 			}
 		}
 
+		void StrokePolyline(const BLPoint* poly, size_t count)
+		{
+			StrokeGeometryArray(BLGeometryType::PolyLine, poly, count);
+		}
+
 		void StrokePolygon(array<BLPointI>^ poly)
 		{
 			if (poly->Length > 0)
 			{
 				Pin(BLPointI, pPoly, poly[0]);
 
-				StrokeGeometry(BLGeometryType::PolygonI, pPoly);
+				StrokeGeometryArray(BLGeometryType::PolygonI, pPoly, poly->Length);
 			}
 		}
 
+		void StrokePolygon(array<BLPointI>^ poly, int index, int count)
+		{
+			CheckArrayRange(poly, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLPointI, pPoly, poly[index]);
+
+				StrokeGeometryArray(BLGeometryType::PolygonI, pPoly, count);
+			}
+		}
+
+		void StrokePolygon(const BLPointI* poly, size_t count)
+		{
+			StrokeGeometryArray(BLGeometryType::PolygonI, poly, count);
+		}
+
 		void StrokePolygon(array<BLPoint>^ poly)
 		{
 			if (poly->Length > 0)
 			{
 				Pin(BLPoint, pPoly, poly[0]);
 
-				StrokeGeometry(BLGeometryType::Polygon, pPoly);
+				StrokeGeometryArray(BLGeometryType::Polygon, pPoly, poly->Length);
+			}
+		}
+
+		void StrokePolygon(array<BLPoint>^ poly, int index, int count)
+		{
+			CheckArrayRange(poly, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLPoint, pPoly, poly[index]);
+
+				StrokeGeometryArray(BLGeometryType::Polygon, pPoly, count);
 			}
 		}
 
+		void StrokePolygon(const BLPoint* poly, size_t count)
+		{
+			StrokeGeometryArray(BLGeometryType::Polygon, poly, count);
+		}
+
 		void StrokeBoxArray(array<BLBoxI>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLBoxI, pArray, array[0]);
 
-				StrokeGeometry(BLGeometryType::BoxIArray, pArray);
+				StrokeGeometryArray(BLGeometryType::BoxIArray, pArray, array->Length);
 			}
 		}
 
+		void StrokeBoxArray(array<BLBoxI>^ array, int index, int count)
+		{
+			CheckArrayRange(array, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLBoxI, pArray, array[index]);
+
+				StrokeGeometryArray(BLGeometryType::BoxIArray, pArray, count);
+			}
+		}
+
+		void StrokeBoxArray(const BLBoxI* array, size_t count)
+		{
+			StrokeGeometryArray(BLGeometryType::BoxIArray, array, count);
+		}
+
 		void StrokeBoxArray(array<BLBox>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLBox, pArray, array[0]);
 
-				StrokeGeometry(BLGeometryType::BoxArray, pArray);
+				StrokeGeometryArray(BLGeometryType::BoxArray, pArray, array->Length);
+			}
+		}
+
+		void StrokeBoxArray(array<BLBox>^ array, int index, int count)
+		{
+			CheckArrayRange(array, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLBox, pArray, array[index]);
+
+				StrokeGeometryArray(BLGeometryType::BoxArray, pArray, count);
 			}
 		}
 
+		void StrokeBoxArray(const BLBox* array, size_t count)
+		{
+			StrokeGeometryArray(BLGeometryType::BoxArray, array, count);
+		}
+
 		void StrokeRectArray(array<BLRectI>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLRectI, pArray, array[0]);
 
-				StrokeGeometry(BLGeometryType::RectIArray, pArray);
+				StrokeGeometryArray(BLGeometryType::RectIArray, pArray, array->Length);
 			}
 		}
 
+		void StrokeRectArray(array<BLRectI>^ array, int index, int count)
+		{
+			CheckArrayRange(array, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLRectI, pArray, array[index]);
+
+				StrokeGeometryArray(BLGeometryType::RectIArray, pArray, count);
+			}
+		}
+
+		void StrokeRectArray(const BLRectI* array, size_t count)
+		{
+			StrokeGeometryArray(BLGeometryType::RectIArray, array, count);
+		}
+
 		void StrokeRectArray(array<BLRect>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLRect, pArray, array[0]);
 
-				StrokeGeometry(BLGeometryType::RectArray, pArray);
+				StrokeGeometryArray(BLGeometryType::RectArray, pArray, array->Length);
+			}
+		}
+
+		void StrokeRectArray(array<BLRect>^ array, int index, int count)
+		{
+			CheckArrayRange(array, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLRect, pArray, array[index]);
+
+				StrokeGeometryArray(BLGeometryType::RectArray, pArray, count);
 			}
 		}
 
+		void StrokeRectArray(const BLRect* array, size_t count)
+		{
+			StrokeGeometryArray(BLGeometryType::RectArray, array, count);
+		}
+
 		void StrokePath(BLPath^ path)
 		{
 			CheckResult(blContextStrokePathD(this, path));
@@ -907,6 +1551,36 @@ namespace Blend2D
 			CheckResult(blContextStrokeTextD(this, Point(pDst), font, str, text->Length, (uint32_t)BLTextEncoding::UTF16));
 		}
 
+		void StrokeText(BLPointI dst, BLFont^ font, String^ text, BLTextRunCache^ cache)
+		{
+			if (cache == nullptr)
+			{
+				StrokeText(dst, font, text);
+				return;
+			}
+
+			auto glyphBuffer = cache->GetGlyphBuffer(font, text);
+
+			StrokeGlyphRun(dst, font, glyphBuffer->GlyphRun);
+
+			GC::KeepAlive(glyphBuffer);
+		}
+
+		void StrokeText(BLPoint dst, BLFont^ font, String^ text, BLTextRunCache^ cache)
+		{
+			if (cache == nullptr)
+			{
+				StrokeText(dst, font, text);
+				return;
+			}
+
+			auto glyphBuffer = cache->GetGlyphBuffer(font, text);
+
+			StrokeGlyphRun(dst, font, glyphBuffer->GlyphRun);
+
+			GC::KeepAlive(glyphBuffer);
+		}
+
 		void StrokeGlyphRun(BLPointI dst, BLFont^ font, BLGlyphRun glyphRun)
 		{
 			Pin(BLPointI, pDst, dst);
@@ -984,6 +1658,30 @@ namespace Blend2D
 
 			CheckResult(blContextBlitScaledImageD(this, Rect(pDst), image, RectI(pArea)));
 		}
+
+		// Blits many areas of one image (typically an atlas) with a single
+		// managed/native transition.
+		void BlitImages(BLImage^ image, array<BLBlitItem>^ items)
+		{
+			BlitImages(image, items, 0, items != nullptr ? items->Length : 0);
+		}
+
+		void BlitImages(BLImage^ image, array<BLBlitItem>^ items, int index, int count)
+		{
+			CheckArrayRange(items, index, count);
+
+			if (count > 0)
+			{
+				Pin(BLBlitItem, pItems, items[index]);
+
+				BlitImages(image, pItems, count);
+			}
+		}
+
+		void BlitImages(BLImage^ image, const BLBlitItem* items, size_t count)
+		{
+			CheckResult(BlitImageBatch(this, image, (const BLBlitItemData*)items, count));
+		}
 	public:
 
 		// Transformations
@@ -1143,6 +1841,89 @@ namespace Blend2D
 			ApplyMatrixOp(BLMatrix2DOp::PostTransform, pM);
 		}
 
+	public:
+
+		// Non-throwing Operations
+
+		BLResultCode TryBegin(BLImage^ image)
+		{
+			targetImage = image;
+			ResetErrors();
+			InvalidateStyleState();
+
+			return (BLResultCode)blContextBegin(this, image, nullptr);
+		}
+
+		BLResultCode TryEnd()
+		{
+			targetImage = nullptr;
+			InvalidateStyleState();
+
+			return (BLResultCode)blContextEnd(this);
+		}
+
+		BLResultCode TryFillRect(BLRect rect)
+		{
+			Pin(BLRect, pRect, rect);
+
+			return (BLResultCode)blContextFillRectD(this, Rect(pRect));
+		}
+
+		BLResultCode TryFillPolygon(const BLPoint* poly, size_t count)
+		{
+			::BLArrayView<uint8_t> view;
+			view.reset(reinterpret_cast<const uint8_t*>(poly), count);
+
+			return (BLResultCode)blContextFillGeometry(this, BL_GEOMETRY_TYPE_POLYGOND, &view);
+		}
+
+		BLResultCode TryFillPath(BLPath^ path)
+		{
+			return (BLResultCode)blContextFillPathD(this, path);
+		}
+
+		BLResultCode TryFillText(BLPoint dst, BLFont^ font, String^ text)
+		{
+			Pin(BLPoint, pDst, dst);
+			ConvertWchar(str, text);
+
+			return (BLResultCode)blContextFillTextD(this, Point(pDst), font, str, text->Length, (uint32_t)BLTextEncoding::UTF16);
+		}
+
+		BLResultCode TryStrokeRect(BLRect rect)
+		{
+			Pin(BLRect, pRect, rect);
+
+			return (BLResultCode)blContextStrokeRectD(this, Rect(pRect));
+		}
+
+		BLResultCode TryStrokePolyline(const BLPoint* poly, size_t count)
+		{
+			::BLArrayView<uint8_t> view;
+			view.reset(reinterpret_cast<const uint8_t*>(poly), count);
+
+			return (BLResultCode)blContextStrokeGeometry(this, BL_GEOMETRY_TYPE_POLYLINED, &view);
+		}
+
+		BLResultCode TryStrokePath(BLPath^ path)
+		{
+			return (BLResultCode)blContextStrokePathD(this, path);
+		}
+
+		BLResultCode TryBlitImage(BLPoint dst, BLImage^ image)
+		{
+			Pin(BLPoint, pDst, dst);
+
+			return (BLResultCode)blContextBlitImageD(this, Point(pDst), image, nullptr);
+		}
+
+		BLResultCode TryBlitImage(BLRect dst, BLImage^ image)
+		{
+			Pin(BLRect, pDst, dst);
+
+			return (BLResultCode)blContextBlitScaledImageD(this, Rect(pDst), image, nullptr);
+		}
+
 	private:
 
 		void FillGeometry(BLGeometryType geometryType, const void* geometryData)
@@ -1155,6 +1936,22 @@ namespace Blend2D
 			CheckResult(blContextStrokeGeometry(this, (uint32_t)geometryType, geometryData));
 		}
 
+		void FillGeometryArray(BLGeometryType geometryType, const void* data, size_t size)
+		{
+			::BLArrayView<uint8_t> view;
+			view.reset(static_cast<const uint8_t*>(data), size);
+
+			FillGeometry(geometryType, &view);
+		}
+
+		void StrokeGeometryArray(BLGeometryType geometryType, const void* data, size_t size)
+		{
+			::BLArrayView<uint8_t> view;
+			view.reset(static_cast<const uint8_t*>(data), size);
+
+			StrokeGeometry(geometryType, &view);
+		}
+
 		void ApplyMatrixOp(BLMatrix2DOp opType, const void* opData)
 		{
 			CheckResult(blContextMatrixOp(this, (uint32_t)opType, opData));
@@ -1174,6 +1971,60 @@ namespace Blend2D
 			CheckResult(blContextMatrixOp(this, (uint32_t)opType, opData));
 		}
 
+		void FlushAndWait()
+		{
+			Flush(BLContextFlushFlags::Sync);
+		}
+
+		void FlushAndNotify(Object^ state)
+		{
+			auto completed = safe_cast<Action<BLResultCode>^>(state);
+
+			completed((BLResultCode)blContextFlush(this, BL_CONTEXT_FLUSH_SYNC));
+		}
+
+		// Scalar state is compared against the native context state, which can
+		// be read without a native call. Styles are not part of that state, so
+		// the last style set through this wrapper is remembered instead.
+		bool IsRedundant(bool unchanged)
+		{
+			if (unchanged)
+			{
+				stateChangesSkipped++;
+				return true;
+			}
+
+			stateChangesIssued++;
+			return false;
+		}
+
+		void TrackStyle(BLResultCode result, uint32_t% kind, uint64_t% value, uint32_t newKind, uint64_t newValue)
+		{
+			kind = result == BLResultCode::BL_SUCCESS ? newKind : StyleUnknown;
+			value = newValue;
+		}
+
+		// Style objects are identified by their impl, which changes on copy-on-write
+		// when a style still referenced by the context gets modified.
+		static uint64_t StyleKey(const BLGradientCore* gradient)
+		{
+			return gradient != nullptr ? (uint64_t)(uintptr_t)gradient->impl : 0;
+		}
+
+		static uint64_t StyleKey(const BLPatternCore* pattern)
+		{
+			return pattern != nullptr ? (uint64_t)(uintptr_t)pattern->impl : 0;
+		}
+
+	internal:
+
+		// Also used by callers that run native work on this context, such as
+		// BLCommandList::Replay, so their failures honor ErrorMode.
+		BLResultCode CheckResult(BLResult result)
+		{
+			return Blend2D::CheckResult(result, errorMode, accumulatedError, accumulatedErrorCount);
+		}
+
 	public:
 
 		property BLImage^ TargetImage
@@ -1184,6 +2035,50 @@ namespace Blend2D
 			}
 		}
 
+		property BLErrorMode ErrorMode
+		{
+			BLErrorMode get()
+			{
+				return errorMode;
+			}
+			void set(BLErrorMode value)
+			{
+				errorMode = value;
+			}
+		}
+
+		property BLResultCode AccumulatedError
+		{
+			BLResultCode get()
+			{
+				return accumulatedError;
+			}
+		}
+
+		property size_t AccumulatedErrorCount
+		{
+			size_t get()
+			{
+				return accumulatedErrorCount;
+			}
+		}
+
+		property uint64_t StateChangesIssued
+		{
+			uint64_t get()
+			{
+				return stateChangesIssued;
+			}
+		}
+
+		property uint64_t StateChangesSkipped
+		{
+			uint64_t get()
+			{
+				return stateChangesSkipped;
+			}
+		}
+
 		property size_t SavedStateCount
 		{
 			size_t get()
@@ -1200,6 +2095,11 @@ namespace Blend2D
 			}
 			void set(BLCompOp value)
 			{
+				if (IsRedundant(impl->compOp() == (uint32_t)value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setCompOp((uint32_t)value));
 			}
 		}
@@ -1220,6 +2120,11 @@ namespace Blend2D
 			}
 			void set(BLFlattenMode value)
 			{
+				if (IsRedundant(impl->flattenMode() == (uint32_t)value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setFlattenMode((uint32_t)value));
 			}
 		}
@@ -1232,6 +2137,11 @@ namespace Blend2D
 			}
 			void set(double value)
 			{
+				if (IsRedundant(impl->flattenTolerance() == value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setFlattenTolerance(value));
 			}
 		}
@@ -1244,6 +2154,11 @@ namespace Blend2D
 			}
 			void set(double value)
 			{
+				if (IsRedundant(impl->globalAlpha() == value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setGlobalAlpha(value));
 			}
 		}
@@ -1256,6 +2171,11 @@ namespace Blend2D
 			}
 			void set(double value)
 			{
+				if (IsRedundant(impl->fillAlpha() == value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setFillAlpha(value));
 			}
 		}
@@ -1268,6 +2188,11 @@ namespace Blend2D
 			}
 			void set(double value)
 			{
+				if (IsRedundant(impl->strokeAlpha() == value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setStrokeAlpha(value));
 			}
 		}
@@ -1280,6 +2205,11 @@ namespace Blend2D
 			}
 			void set(double value)
 			{
+				if (IsRedundant(impl->strokeWidth() == value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setStrokeWidth(value));
 			}
 		}
@@ -1292,6 +2222,11 @@ namespace Blend2D
 			}
 			void set(double value)
 			{
+				if (IsRedundant(impl->strokeMiterLimit() == value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setStrokeMiterLimit(value));
 			}
 		}
@@ -1304,6 +2239,11 @@ namespace Blend2D
 			}
 			void set(double value)
 			{
+				if (IsRedundant(impl->strokeDashOffset() == value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setStrokeDashOffset(value));
 			}
 		}
@@ -1316,6 +2256,11 @@ namespace Blend2D
 			}
 			void set(BLStrokeJoin value)
 			{
+				if (IsRedundant(impl->strokeJoin() == (uint32_t)value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setStrokeJoin((uint32_t)value));
 			}
 		}
@@ -1328,6 +2273,11 @@ namespace Blend2D
 			}
 			void set(BLStrokeCap value)
 			{
+				if (IsRedundant(impl->strokeStartCap() == (uint32_t)value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setStrokeStartCap((uint32_t)value));
 			}
 		}
@@ -1340,6 +2290,11 @@ namespace Blend2D
 			}
 			void set(BLStrokeCap value)
 			{
+				if (IsRedundant(impl->strokeEndCap() == (uint32_t)value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setStrokeEndCap((uint32_t)value));
 			}
 		}
@@ -1352,6 +2307,11 @@ namespace Blend2D
 			}
 			void set(BLStrokeTransformOrder value)
 			{
+				if (IsRedundant(impl->strokeTransformOrder() == (uint32_t)value))
+				{
+					return;
+				}
+
 				CheckResult(impl->setStrokeTransformOrder((uint32_t)value));
 			}
 		}
@@ -1364,6 +2324,11 @@ namespace Blend2D
 			}
 			void set(BLFillRule value)
 			{
+				if (IsRedundant(impl->fillRule() == (uint32_t)value))
+				{
+					return;
+				}
+
 				impl->setFillRule((uint32_t)value);
 			}
 		}
@@ -1378,6 +2343,7 @@ namespace Blend2D
 			}
 			void set(BLStyle^ value)
 			{
+				fillStyleKind = StyleUnknown;
 				CheckResult(blContextSetFillStyle(this, value));
 			}
 		}
@@ -1392,6 +2358,7 @@ namespace Blend2D
 			}
 			void set(BLStyle^ value)
 			{
+				strokeStyleKind = StyleUnknown;
 				CheckResult(blContextSetStrokeStyle(this, value));
 			}
 		}
@@ -5,31 +5,110 @@
 using namespace System;
 using namespace System::Windows::Forms;
 using namespace System::Diagnostics;
+using namespace System::Threading;
 
 namespace Blend2D
 {
 	public ref class BLControlBlt sealed
 	{
+	private:
+
+		ref class BLGdiPresenter sealed : IBLPresenter
+		{
+		internal:
+
+			HDC hdc = nullptr;
+
+		public:
+
+			virtual void Present(BLImage^ image, BLRectI area)
+			{
+				BitBlt(hdc, area.X, area.Y, area.Width, area.Height, image->hdc, area.X, area.Y, SRCCOPY);
+			}
+		};
+
 	private:
 
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
-		BLImage^ image = nullptr;
+		BLSurface^ surface = nullptr;
 
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
 		Action<BLImage^, BLRectI>^ paint = nullptr;
 
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Action<BLImage^, BLRegion^>^ paintRegion = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLDamageAccumulator^ damage = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		array<BLRegion^>^ bufferDamage = nullptr;
+
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
 		int state;
 
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLSwapChain^ swapChain = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLGdiPresenter^ presenter = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Control^ target = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Object^ frameSync = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool frameRequested = false;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool frameScheduled = false;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Exception^ frameError = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool disposed = false;
+
 	public:
 
 		BLControlBlt(Action<BLImage^, BLRectI>^ paint)
+			: BLControlBlt(paint, 1)
+		{
+		}
+
+		// With a buffer count of 2 or 3 the paint callback runs on a thread pool
+		// thread (see RequestFrame) and Paint only presents the newest finished
+		// frame, an exception thrown by the callback is rethrown by the next
+		// Paint. A buffer count of 1 paints synchronously inside Paint.
+		BLControlBlt(Action<BLImage^, BLRectI>^ paint, int bufferCount)
 			: paint(paint), state(0)
 		{
 			if (paint == nullptr)
 			{
 				throw gcnew ArgumentNullException("paint");
 			}
+
+			Initialize(bufferCount);
+		}
+
+		// Region-aware variant, the callback receives only the damaged part of
+		// the image (see Invalidate) instead of its bounding rectangle.
+		BLControlBlt(Action<BLImage^, BLRegion^>^ paint)
+			: BLControlBlt(paint, 1)
+		{
+		}
+
+		BLControlBlt(Action<BLImage^, BLRegion^>^ paint, int bufferCount)
+			: paintRegion(paint), state(0)
+		{
+			if (paint == nullptr)
+			{
+				throw gcnew ArgumentNullException("paint");
+			}
+
+			Initialize(bufferCount);
 		}
 
 		~BLControlBlt()
@@ -46,6 +125,8 @@ namespace Blend2D
 
 		void Paint(Control^ control)
 		{
+			CheckDisposed();
+
 			if (state > 0)
 			{
 				throw gcnew InvalidOperationException("Invalid paint state.");
@@ -55,8 +136,17 @@ namespace Blend2D
 
 			try
 			{
-				Resize(control);
-				PaintAndBlt(control);
+				if (swapChain != nullptr)
+				{
+					ThrowFrameError();
+					ResizeSwapChain(control);
+					PresentSwapChain(control);
+				}
+				else
+				{
+					Resize(control);
+					PaintAndBlt(control);
+				}
 			}
 			finally
 			{
@@ -64,26 +154,147 @@ namespace Blend2D
 			}
 		}
 
+		// Schedules rendering of a new frame into the swap chain, the control is
+		// invalidated once the frame is finished. Requests made while a frame is
+		// being rendered are coalesced into a single following frame.
+		void RequestFrame(Control^ control)
+		{
+			CheckDisposed();
+
+			damage->Add(BLRectI(0, 0, control->Width, control->Height));
+
+			if (swapChain == nullptr)
+			{
+				control->Invalidate();
+				return;
+			}
+
+			ScheduleFrame(control);
+		}
+
+		// Marks rect as damaged. Only damaged pixels are passed to a
+		// region-aware paint callback and blitted to the control.
+		void Invalidate(Control^ control, BLRectI rect)
+		{
+			CheckDisposed();
+
+			damage->Add(rect);
+
+			if (swapChain == nullptr)
+			{
+				control->Invalidate(System::Drawing::Rectangle(rect.X, rect.Y, rect.Width, rect.Height));
+				return;
+			}
+
+			ScheduleFrame(control);
+		}
+
+	public:
+
+		property int BufferCount
+		{
+			int get()
+			{
+				return swapChain != nullptr ? swapChain->BufferCount : 1;
+			}
+		}
+
+		property BLSwapChain^ SwapChain
+		{
+			BLSwapChain^ get()
+			{
+				return swapChain;
+			}
+		}
+
+		property BLSurface^ Surface
+		{
+			BLSurface^ get()
+			{
+				return surface;
+			}
+		}
+
+		property BLDamageAccumulator^ Damage
+		{
+			BLDamageAccumulator^ get()
+			{
+				return damage;
+			}
+		}
+
 	private:
 
-		void Resize(Control^ control)
+		void Initialize(int bufferCount)
+		{
+			if (bufferCount < 1 || bufferCount > 3)
+			{
+				throw gcnew ArgumentOutOfRangeException("bufferCount");
+			}
+
+			auto factory = gcnew Func<int, int, BLImage^>(this, &BLControlBlt::CreateBuffer);
+
+			damage = gcnew BLDamageAccumulator();
+
+			if (bufferCount > 1)
+			{
+				swapChain = gcnew BLSwapChain(bufferCount, factory);
+				presenter = gcnew BLGdiPresenter();
+				frameSync = gcnew Object();
+				bufferDamage = gcnew array<BLRegion^>(bufferCount);
+
+				for (int i = 0; i < bufferCount; i++)
+				{
+					bufferDamage[i] = gcnew BLRegion();
+				}
+			}
+			else
+			{
+				surface = gcnew BLSurface(factory);
+			}
+		}
+
+		void CheckDisposed()
+		{
+			if (disposed)
+			{
+				throw gcnew ObjectDisposedException("BLControlBlt");
+			}
+		}
+
+		void ScheduleFrame(Control^ control)
 		{
-			if (control->Width > 0 || control->Height > 0)
+			Monitor::Enter(frameSync);
+
+			try
 			{
-				if (image == nullptr)
+				if (disposed)
 				{
-					image = gcnew BLImage(control);
+					return;
 				}
-				else if (control->Width != image->Width || control->Height != image->Height)
+
+				target = control;
+				frameRequested = true;
+
+				if (frameScheduled)
 				{
-					delete image;
-					image = gcnew BLImage(control);
+					return;
 				}
+
+				frameScheduled = true;
 			}
-			else
+			finally
 			{
-				Cleanup();
+				Monitor::Exit(frameSync);
 			}
+
+			ThreadPool::QueueUserWorkItem(gcnew WaitCallback(this, &BLControlBlt::RenderFrames));
+		}
+
+		void Resize(Control^ control)
+		{
+			target = control;
+			surface->Resize(control->Width, control->Height);
 		}
 
 		void PaintAndBlt(Control^ control)
@@ -91,11 +302,36 @@ namespace Blend2D
 			PAINTSTRUCT ps;
 
 			auto hwnd = (HWND)control->Handle.ToPointer();
+			auto region = paintRegion != nullptr ? TakeDamage(hwnd) : nullptr;
+
+			if (region == nullptr)
+			{
+				damage->Clear();
+			}
+
 			auto hdc = BeginPaint(hwnd, &ps);
 
 			try
 			{
-				if (paint != nullptr && image != nullptr)
+				auto image = surface->Image;
+
+				if (paintRegion != nullptr && image != nullptr)
+				{
+					region->Intersect(BLBoxI(0, 0, image->Width, image->Height));
+
+					if (!region->IsEmpty)
+					{
+						paintRegion(image, region);
+
+						for (int i = 0; i < region->Count; i++)
+						{
+							auto box = region[i];
+
+							BitBlt(hdc, box.X0, box.Y0, box.X1 - box.X0, box.Y1 - box.Y0, image->hdc, box.X0, box.Y0, SRCCOPY);
+						}
+					}
+				}
+				else if (paint != nullptr && image != nullptr)
 				{
 					auto x = ps.rcPaint.left;
 					auto y = ps.rcPaint.top;
@@ -109,15 +345,322 @@ namespace Blend2D
 			finally
 			{
 				EndPaint(hwnd, &ps);
+
+				if (region != nullptr)
+				{
+					delete region;
+				}
+			}
+		}
+
+		// Returns the accumulated damage together with the update region of
+		// the window, which has to be read before BeginPaint validates it.
+		BLRegion^ TakeDamage(HWND hwnd)
+		{
+			auto region = damage->Take();
+			auto update = CreateRectRgn(0, 0, 0, 0);
+
+			try
+			{
+				if (GetUpdateRgn(hwnd, update, FALSE) > NULLREGION)
+				{
+					auto size = GetRegionData(update, 0, nullptr);
+					auto data = gcnew array<Byte>(size);
+
+					Pin(Byte, pData, data[0]);
+
+					auto rgnData = (RGNDATA*)pData;
+
+					if (GetRegionData(update, size, rgnData) != 0)
+					{
+						auto rects = (RECT*)rgnData->Buffer;
+						auto boxes = gcnew array<BLBoxI>(rgnData->rdh.nCount);
+
+						for (int i = 0; i < boxes->Length; i++)
+						{
+							boxes[i] = BLBoxI(rects[i].left, rects[i].top, rects[i].right, rects[i].bottom);
+						}
+
+						auto windowDamage = gcnew BLRegion();
+
+						try
+						{
+							windowDamage->Assign(boxes);
+							region->Union(windowDamage);
+						}
+						finally
+						{
+							delete windowDamage;
+						}
+					}
+				}
+			}
+			finally
+			{
+				DeleteObject(update);
+			}
+
+			return region;
+		}
+
+		void ResizeSwapChain(Control^ control)
+		{
+			if (control->Width == swapChain->Width && control->Height == swapChain->Height)
+			{
+				return;
+			}
+
+			target = control;
+			swapChain->Resize(control->Width, control->Height);
+
+			RequestFrame(control);
+		}
+
+		void PresentSwapChain(Control^ control)
+		{
+			PAINTSTRUCT ps;
+
+			auto hwnd = (HWND)control->Handle.ToPointer();
+			auto hdc = BeginPaint(hwnd, &ps);
+
+			try
+			{
+				auto x = ps.rcPaint.left;
+				auto y = ps.rcPaint.top;
+				auto width = ps.rcPaint.right - ps.rcPaint.left;
+				auto height = ps.rcPaint.bottom - ps.rcPaint.top;
+
+				presenter->hdc = hdc;
+				swapChain->Present(presenter, BLRectI(x, y, width, height));
+			}
+			finally
+			{
+				presenter->hdc = nullptr;
+				EndPaint(hwnd, &ps);
+			}
+		}
+
+		BLImage^ CreateBuffer(int width, int height)
+		{
+			return gcnew BLImage(target, width, height);
+		}
+
+		// Everything in the loop may throw, including Invalidate on a control
+		// whose handle is being destroyed, and any exception has to reach
+		// FailFrame (see there).
+		void RenderFrames(Object^ unused)
+		{
+			auto chain = swapChain;
+			Control^ control = nullptr;
+
+			try
+			{
+				while (NextFrame(control))
+				{
+					RenderFrame(chain, control);
+				}
+			}
+			catch (Exception^ e)
+			{
+				FailFrame(control, e);
+			}
+		}
+
+		// Ends the frame loop when no frame was requested since the last one or
+		// when Cleanup is waiting for it.
+		bool NextFrame(Control^% control)
+		{
+			Monitor::Enter(frameSync);
+
+			try
+			{
+				if (!frameRequested || disposed)
+				{
+					frameScheduled = false;
+					Monitor::PulseAll(frameSync);
+					return false;
+				}
+
+				frameRequested = false;
+				control = target;
+				return true;
+			}
+			finally
+			{
+				Monitor::Exit(frameSync);
+			}
+		}
+
+		void RenderFrame(BLSwapChain^ chain, Control^ control)
+		{
+			auto back = chain->AcquireBack();
+
+			if (back == nullptr)
+			{
+				delete damage->Take();
+				return;
+			}
+
+			BLBoxI box;
+
+			// An acquired buffer has to be given back on every path, Resize and
+			// Cleanup wait for it.
+			try
+			{
+				auto frameDamage = damage->Take();
+
+				try
+				{
+					frameDamage->Intersect(BLBoxI(0, 0, back->Width, back->Height));
+
+					if (paintRegion != nullptr)
+					{
+						PaintBackRegion(chain->BackIndex, back, frameDamage);
+					}
+					else
+					{
+						paint(back, BLRectI(0, 0, back->Width, back->Height));
+					}
+
+					box = frameDamage->BoundingBox;
+				}
+				finally
+				{
+					delete frameDamage;
+				}
+			}
+			catch (Exception^)
+			{
+				chain->CancelBack();
+				throw;
+			}
+
+			chain->SubmitBack();
+
+			if (control != nullptr && control->IsHandleCreated && !control->IsDisposed)
+			{
+				auto rect = System::Drawing::Rectangle(box.X0, box.Y0, box.X1 - box.X0, box.Y1 - box.Y0);
+
+				control->BeginInvoke(gcnew Action<System::Drawing::Rectangle>(control, &Control::Invalidate), rect);
+			}
+		}
+
+		// An exception escaping a thread pool work item terminates the process,
+		// so it is kept for Paint, which rethrows it on the UI thread. Without a
+		// window handle there is no Paint left to report it.
+		void FailFrame(Control^ control, Exception^ error)
+		{
+			Monitor::Enter(frameSync);
+
+			try
+			{
+				frameError = error;
+				frameScheduled = false;
+				Monitor::PulseAll(frameSync);
+			}
+			finally
+			{
+				Monitor::Exit(frameSync);
+			}
+
+			try
+			{
+				if (control != nullptr && control->IsHandleCreated && !control->IsDisposed)
+				{
+					control->BeginInvoke(gcnew MethodInvoker(control, &Control::Invalidate));
+				}
+			}
+			catch (InvalidOperationException^)
+			{
+			}
+		}
+
+		void ThrowFrameError()
+		{
+			Exception^ error;
+
+			Monitor::Enter(frameSync);
+
+			try
+			{
+				error = frameError;
+				frameError = nullptr;
+			}
+			finally
+			{
+				Monitor::Exit(frameSync);
+			}
+
+			if (error != nullptr)
+			{
+				throw gcnew InvalidOperationException("Rendering a frame failed.", error);
+			}
+		}
+
+		// Each buffer holds an older frame, so it has to repaint everything that
+		// was damaged since it was rendered the last time, not only frameDamage.
+		void PaintBackRegion(int index, BLImage^ back, BLRegion^ frameDamage)
+		{
+			for (int i = 0; i < bufferDamage->Length; i++)
+			{
+				bufferDamage[i]->Union(frameDamage);
+			}
+
+			auto region = bufferDamage[index];
+
+			if (!region->IsEmpty)
+			{
+				paintRegion(back, region);
 			}
+
+			region->Clear();
 		}
 
+		// A frame may be rendering on a thread pool thread, it still uses the
+		// swap chain and the damage accumulator, so both are deleted only once
+		// the frame loop has ended. Closing the swap chain first releases a
+		// renderer that waits for a buffer, the Paint that would free one never
+		// comes.
 		void Cleanup()
 		{
-			if (image != nullptr)
+			if (frameSync != nullptr && swapChain != nullptr)
+			{
+				Monitor::Enter(frameSync);
+
+				try
+				{
+					disposed = true;
+					swapChain->Close();
+
+					while (frameScheduled)
+					{
+						Monitor::Wait(frameSync);
+					}
+				}
+				finally
+				{
+					Monitor::Exit(frameSync);
+				}
+			}
+
+			disposed = true;
+
+			if (surface != nullptr)
+			{
+				delete surface;
+				surface = nullptr;
+			}
+
+			if (swapChain != nullptr)
+			{
+				delete swapChain;
+				swapChain = nullptr;
+			}
+
+			if (damage != nullptr)
 			{
-				delete image;
-				image = nullptr;
+				delete damage;
+				damage = nullptr;
 			}
 		}
 	};
@@ -0,0 +1,90 @@
+#include "pch.h"
+#include "api.h"
+#include "font.h"
+
+// Glyph metrics are computed in one native pass over the glyph buffer, with
+// glyph bounds fetched in fixed-size chunks into a stack buffer.
+#pragma managed(push, off)
+
+namespace Blend2D
+{
+	static const size_t GlyphBoundsChunkSize = 256;
+
+	BLResult ComputeGlyphMetrics(const BLFontCore* font, const BLGlyphBufferCore* glyphBuffer, BLGlyphMetricsData* glyphMetrics)
+	{
+		auto buffer = static_cast<const ::BLGlyphBuffer*>(glyphBuffer);
+		size_t size = buffer->size();
+
+		if (size == 0)
+		{
+			return BL_SUCCESS;
+		}
+
+		::BLFontMatrix matrix;
+		BLResult result = blFontGetMatrix(font, &matrix);
+
+		if (result != BL_SUCCESS)
+		{
+			return result;
+		}
+
+		const uint32_t* content = buffer->content();
+		const ::BLGlyphInfo* infoData = buffer->infoData();
+		const ::BLGlyphPlacement* placementData = buffer->placementData();
+
+		::BLBoxI bounds[GlyphBoundsChunkSize];
+
+		for (size_t start = 0; start < size; start += GlyphBoundsChunkSize)
+		{
+			size_t count = size - start < GlyphBoundsChunkSize ? size - start : GlyphBoundsChunkSize;
+
+			result = blFontGetGlyphBounds(font, content + start, sizeof(uint32_t), bounds, count);
+
+			if (result != BL_SUCCESS)
+			{
+				return result;
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				size_t index = start + i;
+				double advance = placementData != nullptr ? placementData[index].advance.x : 0.0;
+
+				auto& metrics = glyphMetrics[index];
+				metrics.glyphId = content[index];
+				metrics.cluster = infoData != nullptr ? infoData[index].cluster : 0;
+				metrics.advance = advance * matrix.m00;
+				metrics.leadingBearing = bounds[i].x0 * matrix.m00;
+				metrics.trailingBearing = (advance - bounds[i].x1) * matrix.m00;
+				metrics.boundingBox.x0 = bounds[i].x0 * matrix.m00;
+				metrics.boundingBox.x1 = bounds[i].x1 * matrix.m00;
+				metrics.boundingBox.y0 = -(bounds[i].y0 * matrix.m11);
+				metrics.boundingBox.y1 = -(bounds[i].y1 * matrix.m11);
+			}
+		}
+
+		return BL_SUCCESS;
+	}
+}
+
+#pragma managed(pop)
+
+namespace Blend2D
+{
+	// Runs when the last reference to the font data is released, which may
+	// be the native release thread. Exceptions must not reach Blend2D.
+	void BL_CDECL ReleaseFontDataOwner(void* impl, void* destroyData) BL_NOEXCEPT
+	{
+		try
+		{
+			auto handle = GCHandle::FromIntPtr(IntPtr(destroyData));
+			auto owner = safe_cast<BLFontDataOwner^>(handle.Target);
+
+			handle.Free();
+			owner->Release();
+		}
+		catch (Exception^)
+		{
+		}
+	}
+}
@@ -5,6 +5,7 @@
 
 using namespace System;
 using namespace System::Diagnostics;
+using namespace System::IO;
 
 #define TextMetrics(source) (::BLTextMetrics*)(source)
 #define GlyphRun(source) (::BLGlyphRun*)(source)
@@ -26,6 +27,84 @@ namespace Blend2D
 		AbsoluteUnits = BL_GLYPH_PLACEMENT_TYPE_ABSOLUTE_UNITS
 	};
 
+	//! Font stretch.
+	public enum class BLFontStretch : UInt32
+	{
+		//! Ultra condensed stretch.
+		UltraCondensed = BL_FONT_STRETCH_ULTRA_CONDENSED,
+		//! Extra condensed stretch.
+		ExtraCondensed = BL_FONT_STRETCH_EXTRA_CONDENSED,
+		//! Condensed stretch.
+		Condensed = BL_FONT_STRETCH_CONDENSED,
+		//! Semi condensed stretch.
+		SemiCondensed = BL_FONT_STRETCH_SEMI_CONDENSED,
+		//! Normal stretch.
+		Normal = BL_FONT_STRETCH_NORMAL,
+		//! Semi expanded stretch.
+		SemiExpanded = BL_FONT_STRETCH_SEMI_EXPANDED,
+		//! Expanded stretch.
+		Expanded = BL_FONT_STRETCH_EXPANDED,
+		//! Extra expanded stretch.
+		ExtraExpanded = BL_FONT_STRETCH_EXTRA_EXPANDED,
+		//! Ultra expanded stretch.
+		UltraExpanded = BL_FONT_STRETCH_ULTRA_EXPANDED
+	};
+
+	//! Font style.
+	public enum class BLFontStyle : UInt32
+	{
+		//! Normal style.
+		Normal = BL_FONT_STYLE_NORMAL,
+		//! Oblique.
+		Oblique = BL_FONT_STYLE_OBLIQUE,
+		//! Italic.
+		Italic = BL_FONT_STYLE_ITALIC
+	};
+
+	//! Font weight.
+	public enum class BLFontWeight : UInt32
+	{
+		//! Thin weight (100).
+		Thin = BL_FONT_WEIGHT_THIN,
+		//! Extra light weight (200).
+		ExtraLight = BL_FONT_WEIGHT_EXTRA_LIGHT,
+		//! Light weight (300).
+		Light = BL_FONT_WEIGHT_LIGHT,
+		//! Semi light weight (350).
+		SemiLight = BL_FONT_WEIGHT_SEMI_LIGHT,
+		//! Normal weight (400).
+		Normal = BL_FONT_WEIGHT_NORMAL,
+		//! Medium weight (500).
+		Medium = BL_FONT_WEIGHT_MEDIUM,
+		//! Semi bold weight (600).
+		SemiBold = BL_FONT_WEIGHT_SEMI_BOLD,
+		//! Bold weight (700).
+		Bold = BL_FONT_WEIGHT_BOLD,
+		//! Extra bold weight (800).
+		ExtraBold = BL_FONT_WEIGHT_EXTRA_BOLD,
+		//! Black weight (900).
+		Black = BL_FONT_WEIGHT_BLACK,
+		//! Extra black weight (950).
+		ExtraBlack = BL_FONT_WEIGHT_EXTRA_BLACK
+	};
+
+	// Native mirror of BLGlyphMetrics, filled by ComputeGlyphMetrics.
+	struct BLGlyphMetricsData
+	{
+		uint32_t glyphId;
+		uint32_t cluster;
+		double advance;
+		double leadingBearing;
+		double trailingBearing;
+		::BLBox boundingBox;
+	};
+
+	extern BLResult ComputeGlyphMetrics(const BLFontCore* font, const BLGlyphBufferCore* glyphBuffer, BLGlyphMetricsData* glyphMetrics);
+
+	// BLDestroyImplFunc of font data created from caller memory, destroyData
+	// is a GCHandle of the BLFontDataOwner that releases the memory.
+	extern void BL_CDECL ReleaseFontDataOwner(void* impl, void* destroyData) BL_NOEXCEPT;
+
 	public value struct BLGlyphMetrics sealed
 	{
 	internal:
@@ -47,6 +126,56 @@ namespace Blend2D
 
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
 		BLBox boundingBox;
+
+	public:
+
+		property uint32_t GlyphId
+		{
+			uint32_t get()
+			{
+				return glyphId;
+			}
+		}
+
+		property uint32_t Cluster
+		{
+			uint32_t get()
+			{
+				return cluster;
+			}
+		}
+
+		property double Advance
+		{
+			double get()
+			{
+				return advance;
+			}
+		}
+
+		property double LeadingBearing
+		{
+			double get()
+			{
+				return leadingBearing;
+			}
+		}
+
+		property double TrailingBearing
+		{
+			double get()
+			{
+				return trailingBearing;
+			}
+		}
+
+		property BLBox BoundingBox
+		{
+			BLBox get()
+			{
+				return boundingBox;
+			}
+		}
 	};
 
 	public value struct BLGlyphPlacement sealed
@@ -169,6 +298,11 @@ namespace Blend2D
 			return impl;
 		}
 
+		bool Recycle() override
+		{
+			return blGlyphBufferClear(this) == BL_SUCCESS;
+		}
+
 	public:
 
 		void SetText(String^ text)
@@ -557,6 +691,263 @@ namespace Blend2D
 		}
 	};
 
+	// Keeps memory referenced by font data alive until Blend2D destroys it.
+	private ref class BLFontDataOwner sealed
+	{
+	private:
+
+		// Arrays from this size on are allocated in the large object heap.
+		literal int LargeObjectThreshold = 85000;
+
+	private:
+
+		GCHandle pin;
+
+		IntPtr copy;
+
+		Object^ source;
+
+		Action^ release;
+
+		bool released = false;
+
+	public:
+
+		// Small arrays live in the compacted heaps, where a long-lived pin
+		// keeps the GC from compacting around it, so they are copied to native
+		// memory. Large object heap arrays are never moved and are pinned.
+		BLFontDataOwner(array<Byte>^ data)
+			: source(nullptr), release(nullptr)
+		{
+			if (data->Length >= LargeObjectThreshold)
+			{
+				pin = GCHandle::Alloc(data, GCHandleType::Pinned);
+			}
+			else
+			{
+				copy = Marshal::AllocHGlobal(Math::Max(data->Length, 1));
+				Marshal::Copy(data, 0, copy, data->Length);
+			}
+		}
+
+		BLFontDataOwner(Object^ source, Action^ release)
+			: source(source), release(release)
+		{
+		}
+
+	public:
+
+		void Release()
+		{
+			released = true;
+
+			if (pin.IsAllocated)
+			{
+				pin.Free();
+			}
+
+			if (copy != IntPtr::Zero)
+			{
+				Marshal::FreeHGlobal(copy);
+				copy = IntPtr::Zero;
+			}
+
+			source = nullptr;
+
+			if (release != nullptr)
+			{
+				release();
+			}
+		}
+
+	public:
+
+		property void* Data
+		{
+			void* get()
+			{
+				return copy != IntPtr::Zero ? copy.ToPointer() : pin.AddrOfPinnedObject().ToPointer();
+			}
+		}
+
+		property bool IsReleased
+		{
+			bool get()
+			{
+				return released;
+			}
+		}
+	};
+
+	public ref class BLFontData sealed : public BLObject
+	{
+	private:
+
+		typedef ::BLFontData ImplType;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<ImplType> impl;
+
+	public:
+
+		BLFontData()
+			: BLObject()
+		{
+		}
+
+		BLFontData(String^ fileName)
+			: BLObject()
+		{
+			CreateFromFile(fileName, BLFileReadFlags::None);
+		}
+
+		BLFontData(String^ fileName, BLFileReadFlags readFlags)
+			: BLObject()
+		{
+			CreateFromFile(fileName, readFlags);
+		}
+
+		BLFontData(array<Byte>^ data)
+			: BLObject()
+		{
+			CreateFromData(data);
+		}
+
+	internal:
+
+		operator ImplType* ()
+		{
+			if (Object::ReferenceEquals(this, nullptr))
+			{
+				return nullptr;
+			}
+
+			return impl;
+		}
+
+	public:
+
+		void CreateFromFile(String^ fileName)
+		{
+			CreateFromFile(fileName, BLFileReadFlags::None);
+		}
+
+		// With BLFileReadFlags::MmapEnabled the file is mapped instead of read,
+		// so tables of large fonts are paged in only when used.
+		void CreateFromFile(String^ fileName, BLFileReadFlags readFlags)
+		{
+			ConvertChar(str, fileName);
+
+			CheckResult(blFontDataCreateFromFile(this, str, (uint32_t)readFlags));
+
+			SetMemoryPressure((readFlags & BLFileReadFlags::MmapEnabled) == BLFileReadFlags::MmapEnabled ? 0 : (gcnew System::IO::FileInfo(fileName))->Length);
+		}
+
+		// Arrays of 85000 bytes and more live in the large object heap, which
+		// is not compacted, and are used in place, pinned until the font data
+		// and all faces created from it are destroyed. Smaller arrays are
+		// copied to native memory, freed at the same point.
+		void CreateFromData(array<Byte>^ data)
+		{
+			if (data == nullptr)
+			{
+				throw gcnew ArgumentNullException("data");
+			}
+
+			auto owner = gcnew BLFontDataOwner(data);
+
+			CreateFromOwner(owner, owner->Data, data->Length);
+		}
+
+		// Uses caller-owned memory in place, release runs once Blend2D no
+		// longer references it, possibly on another thread.
+		void CreateFromData(IntPtr data, int64_t size, Action^ release)
+		{
+			if (data == IntPtr::Zero)
+			{
+				throw gcnew ArgumentNullException("data");
+			}
+
+			if (size <= 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("size");
+			}
+
+			CreateFromOwner(gcnew BLFontDataOwner(nullptr, release), data.ToPointer(), (size_t)size);
+		}
+
+		// Embedded resources are returned as UnmanagedMemoryStream and used in
+		// place, other streams are read into an array from their position.
+		void CreateFromStream(Stream^ stream)
+		{
+			if (stream == nullptr)
+			{
+				throw gcnew ArgumentNullException("stream");
+			}
+
+			auto unmanagedStream = dynamic_cast<UnmanagedMemoryStream^>(stream);
+
+			if (unmanagedStream != nullptr)
+			{
+				auto size = unmanagedStream->Length - unmanagedStream->Position;
+
+				if (size <= 0)
+				{
+					throw gcnew ArgumentException("Stream is empty.", "stream");
+				}
+
+				CreateFromOwner(gcnew BLFontDataOwner(stream, nullptr), unmanagedStream->PositionPointer, (size_t)size);
+				return;
+			}
+
+			auto buffer = gcnew MemoryStream();
+
+			stream->CopyTo(buffer);
+
+			CreateFromData(buffer->Length == buffer->Capacity ? buffer->GetBuffer() : buffer->ToArray());
+		}
+
+	private:
+
+		void CreateFromOwner(BLFontDataOwner^ owner, void* data, size_t size)
+		{
+			auto handle = GCHandle::Alloc(owner);
+			auto result = blFontDataCreateFromData(this, data, size, &ReleaseFontDataOwner, GCHandle::ToIntPtr(handle).ToPointer());
+
+			// Blend2D calls the destroy function itself when creation fails after
+			// it took ownership, an earlier failure leaves the owner to us.
+			if (result != BL_SUCCESS && !owner->IsReleased)
+			{
+				handle.Free();
+				owner->Release();
+			}
+
+			CheckResult(result);
+
+			SetMemoryPressure(0);
+		}
+
+	public:
+
+		property int FaceCount
+		{
+			int get()
+			{
+				return (int)impl->faceCount();
+			}
+		}
+
+		property bool IsEmpty
+		{
+			bool get()
+			{
+				return impl->empty();
+			}
+		}
+	};
+
 	public ref class BLFontFace sealed : public BLObject
 	{
 	private:
@@ -581,6 +972,18 @@ namespace Blend2D
 			CreateFromFile(fileName);
 		}
 
+		BLFontFace(String^ fileName, int faceIndex)
+			: BLObject()
+		{
+			CreateFromFile(fileName, faceIndex);
+		}
+
+		BLFontFace(BLFontData^ fontData, int faceIndex)
+			: BLObject()
+		{
+			CreateFromData(fontData, faceIndex);
+		}
+
 	internal:
 
 		operator ImplType* ()
@@ -600,6 +1003,45 @@ namespace Blend2D
 			ConvertChar(str, fileName);
 
 			CheckResult(blFontFaceCreateFromFile(this, str, 0));
+
+			SetMemoryPressure((gcnew System::IO::FileInfo(fileName))->Length);
+		}
+
+		// Loads one face of a font collection (.ttc), faceIndex 0 is the first.
+		void CreateFromFile(String^ fileName, int faceIndex)
+		{
+			if (faceIndex < 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("faceIndex");
+			}
+
+			ConvertChar(str, fileName);
+
+			::BLFontData fontData;
+
+			CheckResult(blFontDataCreateFromFile(&fontData, str, 0));
+			CheckResult(blFontFaceCreateFromData(this, &fontData, (uint32_t)faceIndex));
+
+			SetMemoryPressure((gcnew System::IO::FileInfo(fileName))->Length);
+		}
+
+		// The face references fontData, memory given to it stays in use until
+		// the face is destroyed as well.
+		void CreateFromData(BLFontData^ fontData, int faceIndex)
+		{
+			if (fontData == nullptr)
+			{
+				throw gcnew ArgumentNullException("fontData");
+			}
+
+			if (faceIndex < 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("faceIndex");
+			}
+
+			CheckResult(blFontFaceCreateFromData(this, fontData, (uint32_t)faceIndex));
+
+			SetMemoryPressure(0);
 		}
 
 	public:
@@ -635,6 +1077,38 @@ namespace Blend2D
 				return gcnew String(impl->postScriptName());
 			}
 		}
+
+		property BLFontWeight Weight
+		{
+			BLFontWeight get()
+			{
+				return (BLFontWeight)impl->weight();
+			}
+		}
+
+		property BLFontStyle Style
+		{
+			BLFontStyle get()
+			{
+				return (BLFontStyle)impl->style();
+			}
+		}
+
+		property BLFontStretch Stretch
+		{
+			BLFontStretch get()
+			{
+				return (BLFontStretch)impl->stretch();
+			}
+		}
+
+		property int FaceIndex
+		{
+			int get()
+			{
+				return (int)impl->faceIndex();
+			}
+		}
 	};
 
 	public ref class BLFont sealed : public BLObject
@@ -712,31 +1186,35 @@ namespace Blend2D
 
 		void GetGlyphMetrics(BLGlyphBuffer^ glyphBuffer, array<BLGlyphMetrics>^% glyphMetrics)
 		{
-			auto mx = Matrix.M00;
-			auto my = Matrix.M11;
-			auto size = glyphBuffer->Size;
-			auto glyphData = glyphBuffer->Content;
-			auto placementData = glyphBuffer->PlacementData;
+			glyphMetrics = gcnew array<BLGlyphMetrics>((int)glyphBuffer->Size);
 
-			array<BLBoxI>^ glyphBounds;
+			GetGlyphMetrics(glyphBuffer, glyphMetrics, 0);
+		}
 
-			GetGlyphBounds(glyphBuffer, glyphData, glyphBounds, size);
+		int GetGlyphMetrics(BLGlyphBuffer^ glyphBuffer, array<BLGlyphMetrics>^ glyphMetrics, int index)
+		{
+			auto size = (int)glyphBuffer->Size;
+
+			CheckArrayRange(glyphMetrics, index, size);
+
+			if (size > 0)
+			{
+				Pin(BLGlyphMetrics, pGlyphMetrics, glyphMetrics[index]);
 
-			glyphMetrics = gcnew array<BLGlyphMetrics>((long)size);
+				CheckResult(ComputeGlyphMetrics(this, glyphBuffer, (BLGlyphMetricsData*)pGlyphMetrics));
+			}
 
-			Pin(BLGlyphMetrics, pGlyphMetrics, glyphMetrics[0]);
+			return size;
+		}
 
-			for (long i = 0; i < (long)size; i++)
+		void GetGlyphMetrics(BLGlyphBuffer^ glyphBuffer, BLGlyphMetrics* glyphMetrics, size_t count)
+		{
+			if (count < glyphBuffer->Size)
 			{
-				pGlyphMetrics[i].glyphId = glyphData[i];
-				pGlyphMetrics[i].advance = placementData[i].Advance.X * mx;
-				pGlyphMetrics[i].leadingBearing = glyphBounds[0].X0 * mx;
-				pGlyphMetrics[i].trailingBearing = (placementData[i].Advance.X - glyphBounds[0].X1) * mx;
-				pGlyphMetrics[i].boundingBox.X0 = glyphBounds[i].X0 * mx;
-				pGlyphMetrics[i].boundingBox.X1 = glyphBounds[i].X1 * mx;
-				pGlyphMetrics[i].boundingBox.Y0 = -(glyphBounds[i].Y0 * my);
-				pGlyphMetrics[i].boundingBox.Y1 = -(glyphBounds[i].Y1 * my);
+				throw gcnew ArgumentOutOfRangeException("count");
 			}
+
+			CheckResult(ComputeGlyphMetrics(this, glyphBuffer, (BLGlyphMetricsData*)glyphMetrics));
 		}
 
 	public:
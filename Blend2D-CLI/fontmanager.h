@@ -0,0 +1,459 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "font.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+using namespace System::IO;
+using namespace System::Text;
+using namespace System::Threading;
+
+#define FontQueryProperties(source) (::BLFontQueryProperties*)(source)
+
+namespace Blend2D
+{
+	public value struct BLFontQueryProperties sealed
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint32_t style;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint32_t weight;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint32_t stretch;
+
+	public:
+
+		BLFontQueryProperties(BLFontStyle style, BLFontWeight weight)
+			: BLFontQueryProperties(style, weight, BLFontStretch::Normal)
+		{
+		}
+
+		BLFontQueryProperties(BLFontStyle style, BLFontWeight weight, BLFontStretch stretch)
+			: style((uint32_t)style), weight((uint32_t)weight), stretch((uint32_t)stretch)
+		{
+		}
+
+	public:
+
+		String^ ToString() override
+		{
+			return String::Format("Style={0}, Weight={1}, Stretch={2}", Style, Weight, Stretch);
+		}
+
+	public:
+
+		property BLFontStyle Style
+		{
+			BLFontStyle get()
+			{
+				return (BLFontStyle)style;
+			}
+		}
+
+		property BLFontWeight Weight
+		{
+			BLFontWeight get()
+			{
+				return (BLFontWeight)weight;
+			}
+		}
+
+		property BLFontStretch Stretch
+		{
+			BLFontStretch get()
+			{
+				return (BLFontStretch)stretch;
+			}
+		}
+	};
+
+	public ref class BLFontManager sealed : public BLObject
+	{
+	private:
+
+		typedef ::BLFontManager ImplType;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<ImplType> impl;
+
+	public:
+
+		BLFontManager()
+			: BLObject()
+		{
+			CheckResult(blFontManagerCreate(this));
+		}
+
+	internal:
+
+		operator ImplType* ()
+		{
+			if (Object::ReferenceEquals(this, nullptr))
+			{
+				return nullptr;
+			}
+
+			return impl;
+		}
+
+	public:
+
+		void AddFace(BLFontFace^ face)
+		{
+			CheckResult(blFontManagerAddFace(this, face));
+		}
+
+		bool HasFace(BLFontFace^ face)
+		{
+			return blFontManagerHasFace(this, face);
+		}
+
+		BLFontFace^ QueryFace(String^ familyName)
+		{
+			return QueryFace(familyName, BLFontQueryProperties(BLFontStyle::Normal, BLFontWeight::Normal));
+		}
+
+		BLFontFace^ QueryFace(String^ familyName, BLFontQueryProperties properties)
+		{
+			BLFontFace^ face;
+
+			if (!TryQueryFace(familyName, properties, face))
+			{
+				throw gcnew ArgumentException(String::Format("No font face matches '{0}'.", familyName), "familyName");
+			}
+
+			return face;
+		}
+
+		// Style has the highest priority when selecting the best match,
+		// weight the lowest.
+		bool TryQueryFace(String^ familyName, BLFontQueryProperties properties, BLFontFace^% face)
+		{
+			auto name = EncodeName(familyName);
+			auto found = gcnew BLFontFace();
+
+			Pin(BLFontQueryProperties, pProperties, properties);
+			Pin(Byte, pName, name[0]);
+
+			auto result = blFontManagerQueryFace(this, (const char*)pName, name->Length - 1, FontQueryProperties(pProperties), found);
+
+			if (result == BL_ERROR_FONT_NO_MATCH)
+			{
+				face = nullptr;
+				return false;
+			}
+
+			CheckResult(result);
+
+			face = found;
+			return true;
+		}
+
+		array<BLFontFace^>^ QueryFacesByFamilyName(String^ familyName)
+		{
+			auto name = EncodeName(familyName);
+
+			Pin(Byte, pName, name[0]);
+
+			BLArray< ::BLFontFace> faces;
+
+			CheckResult(blFontManagerQueryFacesByFamilyName(this, (const char*)pName, name->Length - 1, &faces));
+
+			auto result = gcnew array<BLFontFace^>((int)faces.size());
+
+			for (int i = 0; i < result->Length; i++)
+			{
+				result[i] = gcnew BLFontFace();
+
+				CheckResult(blFontFaceAssignWeak(result[i], &faces[i]));
+			}
+
+			return result;
+		}
+
+	private:
+
+		// UTF-8 with a terminating zero, so even an empty name can be pinned.
+		static array<Byte>^ EncodeName(String^ name)
+		{
+			if (name == nullptr)
+			{
+				throw gcnew ArgumentNullException("familyName");
+			}
+
+			auto bytes = gcnew array<Byte>(Encoding::UTF8->GetByteCount(name) + 1);
+
+			Encoding::UTF8->GetBytes(name, 0, name->Length, bytes, 0);
+
+			return bytes;
+		}
+
+	public:
+
+		property int FaceCount
+		{
+			int get()
+			{
+				return (int)blFontManagerGetFaceCount(this);
+			}
+		}
+
+		property int FamilyCount
+		{
+			int get()
+			{
+				return (int)blFontManagerGetFamilyCount(this);
+			}
+		}
+	};
+
+	// Process-wide cache of font faces keyed by canonical file path and face
+	// index, so every component asking for the same font shares one parsed
+	// face. Faces handed out are shared and must not be disposed. Every face
+	// loaded through the cache is also added to Manager.
+	public ref class BLFontFaceCache abstract sealed
+	{
+	private:
+
+		value struct Key : IEquatable<Key>
+		{
+			String^ path;
+			int faceIndex;
+
+			Key(String^ path, int faceIndex)
+				: path(path), faceIndex(faceIndex)
+			{
+			}
+
+			virtual bool Equals(Key other)
+			{
+				return faceIndex == other.faceIndex && String::Equals(path, other.path, StringComparison::OrdinalIgnoreCase);
+			}
+
+			bool Equals(Object^ other) override
+			{
+				return other != nullptr && other->GetType() == Key::typeid && Equals(safe_cast<Key>(other));
+			}
+
+			int GetHashCode() override
+			{
+				return StringComparer::OrdinalIgnoreCase->GetHashCode(path) ^ (faceIndex * 31);
+			}
+		};
+
+	private:
+
+		static Object^ sync = gcnew Object();
+
+		static Dictionary<Key, BLFontFace^>^ faces = gcnew Dictionary<Key, BLFontFace^>();
+
+		static BLFontManager^ manager = nullptr;
+
+		static int64_t hits = 0;
+
+		static int64_t misses = 0;
+
+	public:
+
+		static BLFontFace^ GetFace(String^ fileName)
+		{
+			return GetFace(fileName, 0);
+		}
+
+		static BLFontFace^ GetFace(String^ fileName, int faceIndex)
+		{
+			if (fileName == nullptr)
+			{
+				throw gcnew ArgumentNullException("fileName");
+			}
+
+			auto key = Key(Path::GetFullPath(fileName), faceIndex);
+
+			BLFontFace^ face;
+
+			Monitor::Enter(sync);
+
+			try
+			{
+				if (faces->TryGetValue(key, face))
+				{
+					hits++;
+					return face;
+				}
+
+				// Loading under the lock keeps concurrent requests for the same
+				// file from parsing it twice. Files are mapped, so large fonts
+				// are paged in only as far as their glyphs are used.
+				face = LoadFace(key.path, faceIndex);
+
+				GetManager()->AddFace(face);
+				faces->Add(key, face);
+				misses++;
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+
+			return face;
+		}
+
+		// Loads the faces of several files into the cache at startup, later
+		// family queries through Manager are then hash lookups.
+		static void Preload(IEnumerable<String^>^ fileNames)
+		{
+			if (fileNames == nullptr)
+			{
+				throw gcnew ArgumentNullException("fileNames");
+			}
+
+			for each (String^ fileName in fileNames)
+			{
+				GetFace(fileName);
+			}
+		}
+
+		static BLFontFace^ QueryFace(String^ familyName, BLFontQueryProperties properties)
+		{
+			BLFontFace^ face;
+
+			Monitor::Enter(sync);
+
+			try
+			{
+				GetManager()->TryQueryFace(familyName, properties, face);
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+
+			return face;
+		}
+
+		// Drops the cache references, faces already handed out stay valid.
+		static void Clear()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				faces->Clear();
+				manager = nullptr;
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+	private:
+
+		// Cached objects are created outside of the object pool of the calling
+		// thread, which would dispose them when its scope ends.
+		static BLFontFace^ LoadFace(String^ path, int faceIndex)
+		{
+			auto pool = BLObjectPool::Suspend();
+
+			try
+			{
+				auto fontData = gcnew BLFontData(path, BLFileReadFlags::MmapEnabled | BLFileReadFlags::MmapAvoidSmall);
+
+				try
+				{
+					return gcnew BLFontFace(fontData, faceIndex);
+				}
+				finally
+				{
+					delete fontData;
+				}
+			}
+			finally
+			{
+				BLObjectPool::Resume(pool);
+			}
+		}
+
+		static BLFontManager^ GetManager()
+		{
+			if (manager == nullptr)
+			{
+				auto pool = BLObjectPool::Suspend();
+
+				try
+				{
+					manager = gcnew BLFontManager();
+				}
+				finally
+				{
+					BLObjectPool::Resume(pool);
+				}
+			}
+
+			return manager;
+		}
+
+	public:
+
+		// Font manager holding all cached faces. It is shared, queries through
+		// QueryFace are serialized with the cache.
+		static property BLFontManager^ Manager
+		{
+			BLFontManager^ get()
+			{
+				Monitor::Enter(sync);
+
+				try
+				{
+					return GetManager();
+				}
+				finally
+				{
+					Monitor::Exit(sync);
+				}
+			}
+		}
+
+		static property int Count
+		{
+			int get()
+			{
+				Monitor::Enter(sync);
+
+				try
+				{
+					return faces->Count;
+				}
+				finally
+				{
+					Monitor::Exit(sync);
+				}
+			}
+		}
+
+		static property int64_t Hits
+		{
+			int64_t get()
+			{
+				return Interlocked::Read(hits);
+			}
+		}
+
+		static property int64_t Misses
+		{
+			int64_t get()
+			{
+				return Interlocked::Read(misses);
+			}
+		}
+	};
+}
@@ -0,0 +1,912 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "geometry.h"
+#include "rgba.h"
+#include "image.h"
+#include "font.h"
+#include "textcache.h"
+#include "context.h"
+#include "atlas.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+
+namespace Blend2D
+{
+	// Caches rasterized glyphs of small text in a PRGB32 atlas. Each glyph is
+	// rendered once per face, size, color and horizontal subpixel bucket and
+	// later text is composed with a single BLContext::BlitImages call. Text
+	// larger than MaxFontSize or drawn with a scaling or rotating matrix is
+	// filled as outlines instead. The atlas is split into horizontal pages,
+	// when it is full the least recently used page is evicted. Instances are
+	// not thread safe, use one per rendering thread.
+	public ref class BLGlyphAtlas sealed
+	{
+	public:
+
+		literal int DefaultSize = 1024;
+
+		literal int DefaultSubpixelBuckets = 4;
+
+		literal double DefaultMaxFontSize = 32.0;
+
+	private:
+
+		literal int PageCount = 4;
+
+		literal int MaxOversizedRuns = 64;
+
+	private:
+
+		value struct GlyphKey : IEquatable<GlyphKey>
+		{
+			IntPtr face;
+			float size;
+			uint32_t glyphId;
+			uint32_t color;
+			int bucket;
+
+			GlyphKey(IntPtr face, float size, uint32_t glyphId, uint32_t color, int bucket)
+				: face(face), size(size), glyphId(glyphId), color(color), bucket(bucket)
+			{
+			}
+
+			virtual bool Equals(GlyphKey other)
+			{
+				return face == other.face && size == other.size && glyphId == other.glyphId && color == other.color && bucket == other.bucket;
+			}
+
+			bool Equals(Object^ other) override
+			{
+				return other != nullptr && other->GetType() == GlyphKey::typeid && Equals(safe_cast<GlyphKey>(other));
+			}
+
+			int GetHashCode() override
+			{
+				return (int)(glyphId * 0x9E3779B1u) ^ face.GetHashCode() ^ (int)color ^ (bucket << 28) ^ (size.GetHashCode() * 31);
+			}
+		};
+
+		// Glyph ids of a run that did not fit into an empty atlas.
+		value struct RunKey : IEquatable<RunKey>
+		{
+			IntPtr face;
+			float size;
+			uint32_t color;
+			uint64_t glyphsHash;
+			int count;
+
+			RunKey(IntPtr face, float size, uint32_t color, uint64_t glyphsHash, int count)
+				: face(face), size(size), color(color), glyphsHash(glyphsHash), count(count)
+			{
+			}
+
+			virtual bool Equals(RunKey other)
+			{
+				return face == other.face && size == other.size && color == other.color && glyphsHash == other.glyphsHash && count == other.count;
+			}
+
+			bool Equals(Object^ other) override
+			{
+				return other != nullptr && other->GetType() == RunKey::typeid && Equals(safe_cast<RunKey>(other));
+			}
+
+			int GetHashCode() override
+			{
+				return (int)(glyphsHash ^ (glyphsHash >> 32)) ^ face.GetHashCode() ^ (int)color ^ (count * 31);
+			}
+		};
+
+		// Area of a glyph in the atlas, origin is the position of the glyph
+		// origin inside of the area. Empty glyphs have an empty area.
+		value struct GlyphSlot
+		{
+			BLRectI area;
+			int originX;
+			int originY;
+			int page;
+		};
+
+		value struct PendingGlyph
+		{
+			GlyphKey key;
+			uint32_t glyphId;
+			double x;
+			double y;
+		};
+
+		// Keeps a face alive, so its address is not reused while the atlas
+		// holds its glyphs. Released with the last slot of the face.
+		ref class FontEntry sealed
+		{
+		public:
+
+			BLFont^ font;
+			int slotCount;
+		};
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLImage^ image;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		array<BLImageAtlas^>^ pages;
+
+		// Run stamp of the last run that used a page, the page with the lowest
+		// one is evicted first.
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		array<int64_t>^ pageUse;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int currentPage = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t runStamp = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int subpixelBuckets;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		double maxFontSize = DefaultMaxFontSize;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Dictionary<GlyphKey, GlyphSlot>^ slots;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Dictionary<IntPtr, FontEntry^>^ fonts;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		HashSet<RunKey>^ oversizedRuns;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		List<PendingGlyph>^ pending;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		List<GlyphKey>^ evicted;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		array<BLBlitItem>^ items;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLGlyphBuffer^ glyphBuffer = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLTextRunCache^ textRunCache = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t hits = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t misses = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t fallbacks = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t evictions = 0;
+
+	public:
+
+		BLGlyphAtlas()
+			: BLGlyphAtlas(DefaultSize, DefaultSize, DefaultSubpixelBuckets)
+		{
+		}
+
+		// Glyphs are positioned horizontally in steps of 1 / subpixelBuckets
+		// pixels and snapped to whole pixels vertically.
+		BLGlyphAtlas(int width, int height, int subpixelBuckets)
+		{
+			if (width <= 0 || height <= 0)
+			{
+				throw gcnew ArgumentOutOfRangeException(width <= 0 ? "width" : "height");
+			}
+
+			if (subpixelBuckets < 1 || subpixelBuckets > 16)
+			{
+				throw gcnew ArgumentOutOfRangeException("subpixelBuckets");
+			}
+
+			auto pageCount = Math::Min((int)PageCount, height);
+
+			this->image = gcnew BLImage(width, height, BLFormat::PRGB32);
+			this->pages = gcnew array<BLImageAtlas^>(pageCount);
+			this->pageUse = gcnew array<int64_t>(pageCount);
+
+			for (int i = 0; i < pageCount; i++)
+			{
+				auto top = i * height / pageCount;
+				auto bottom = (i + 1) * height / pageCount;
+
+				pages[i] = gcnew BLImageAtlas(image, BLRectI(0, top, width, bottom - top), BLImageAtlas::DefaultPadding);
+			}
+
+			this->subpixelBuckets = subpixelBuckets;
+			this->slots = gcnew Dictionary<GlyphKey, GlyphSlot>();
+			this->fonts = gcnew Dictionary<IntPtr, FontEntry^>();
+			this->oversizedRuns = gcnew HashSet<RunKey>();
+			this->pending = gcnew List<PendingGlyph>();
+			this->evicted = gcnew List<GlyphKey>();
+			this->items = gcnew array<BLBlitItem>(64);
+		}
+
+		~BLGlyphAtlas()
+		{
+			for (int i = 0; i < pages->Length; i++)
+			{
+				delete pages[i];
+			}
+
+			delete image;
+		}
+
+	public:
+
+		// Draws text with color. The fill style of context is changed when the
+		// text has to be filled as outlines.
+		void FillText(BLContext^ context, BLPoint dst, BLFont^ font, String^ text, BLRgba32 color)
+		{
+			if (font == nullptr)
+			{
+				throw gcnew ArgumentNullException("font");
+			}
+
+			if (text == nullptr)
+			{
+				throw gcnew ArgumentNullException("text");
+			}
+
+			BLGlyphBuffer^ shaped;
+
+			if (textRunCache != nullptr)
+			{
+				shaped = textRunCache->GetGlyphBuffer(font, text);
+			}
+			else
+			{
+				if (glyphBuffer == nullptr)
+				{
+					// Reused by later calls, so it must outlive the object pool
+					// of the calling thread.
+					auto pool = BLObjectPool::Suspend();
+
+					try
+					{
+						glyphBuffer = gcnew BLGlyphBuffer();
+					}
+					finally
+					{
+						BLObjectPool::Resume(pool);
+					}
+				}
+
+				glyphBuffer->SetText(text);
+				font->Shape(glyphBuffer);
+				shaped = glyphBuffer;
+			}
+
+			FillGlyphBuffer(context, dst, font, shaped, color);
+		}
+
+		// Draws glyphs shaped by font, glyphBuffer must hold glyph ids.
+		void FillGlyphBuffer(BLContext^ context, BLPoint dst, BLFont^ font, BLGlyphBuffer^ glyphBuffer, BLRgba32 color)
+		{
+			if (context == nullptr)
+			{
+				throw gcnew ArgumentNullException("context");
+			}
+
+			if (font == nullptr)
+			{
+				throw gcnew ArgumentNullException("font");
+			}
+
+			if (glyphBuffer == nullptr)
+			{
+				throw gcnew ArgumentNullException("glyphBuffer");
+			}
+
+			const ::BLFont* nativeFont = font;
+			const ::BLGlyphBuffer* nativeBuffer = glyphBuffer;
+
+			double tx, ty;
+
+			if (nativeBuffer->size() == 0)
+			{
+				return;
+			}
+
+			if (nativeBuffer->placementData() == nullptr || !CanBlit(context, nativeFont, tx, ty))
+			{
+				FillOutlines(context, dst, font, glyphBuffer, color);
+				return;
+			}
+
+			if (oversizedRuns->Count > 0 && oversizedRuns->Contains(GetRunKey(nativeFont, nativeBuffer, color.value)))
+			{
+				FillOutlines(context, dst, font, glyphBuffer, color);
+				return;
+			}
+
+			// Prepare evicts single pages, a run that still fails needs pages it
+			// uses itself. It gets one flush of the whole atlas, a run that does
+			// not fit into the empty atlas either is filled as outlines and not
+			// tried again.
+			if (!Prepare(nativeFont, nativeBuffer, dst.X + tx, dst.Y + ty, tx, ty, color.value))
+			{
+				ClearPages();
+
+				if (!Prepare(nativeFont, nativeBuffer, dst.X + tx, dst.Y + ty, tx, ty, color.value))
+				{
+					DropPending();
+					RememberOversized(GetRunKey(nativeFont, nativeBuffer, color.value));
+
+					FillOutlines(context, dst, font, glyphBuffer, color);
+					return;
+				}
+			}
+
+			RenderPending(font, color);
+
+			context->BlitImages(image, items, 0, CompactItems((int)nativeBuffer->size()));
+
+			GC::KeepAlive(glyphBuffer);
+		}
+
+		// Returns true when text drawn with font into context would be
+		// composed from the atlas.
+		bool CanBlit(BLContext^ context, BLFont^ font)
+		{
+			if (context == nullptr)
+			{
+				throw gcnew ArgumentNullException("context");
+			}
+
+			if (font == nullptr)
+			{
+				throw gcnew ArgumentNullException("font");
+			}
+
+			const ::BLFont* nativeFont = font;
+
+			double tx, ty;
+
+			return CanBlit(context, nativeFont, tx, ty);
+		}
+
+		void Clear()
+		{
+			ClearPages();
+			oversizedRuns->Clear();
+		}
+
+		void ResetStatistics()
+		{
+			hits = 0;
+			misses = 0;
+			fallbacks = 0;
+			evictions = 0;
+		}
+
+	private:
+
+		bool CanBlit(BLContext^ context, const ::BLFont* font, double% tx, double% ty)
+		{
+			const auto& fontMatrix = font->matrix();
+
+			if (font->size() > maxFontSize || fontMatrix.m01 != 0.0 || fontMatrix.m10 != 0.0)
+			{
+				return false;
+			}
+
+			auto metaMatrix = context->MetaMatrix;
+			auto userMatrix = context->UserMatrix;
+
+			if (!IsTranslation(metaMatrix) || !IsTranslation(userMatrix))
+			{
+				return false;
+			}
+
+			tx = metaMatrix.M20 + userMatrix.M20;
+			ty = metaMatrix.M21 + userMatrix.M21;
+			return true;
+		}
+
+		static bool IsTranslation(BLMatrix2D matrix)
+		{
+			auto type = matrix.Type;
+
+			return type == BLMatrix2DType::Identity || type == BLMatrix2DType::Translate;
+		}
+
+		// Looks up or reserves a slot for every glyph and fills items with the
+		// blits in user coordinates. Returns false when the atlas is full.
+		bool Prepare(const ::BLFont* font, const ::BLGlyphBuffer* glyphBuffer, double x, double y, double tx, double ty, uint32_t color)
+		{
+			auto size = (int)glyphBuffer->size();
+			auto face = IntPtr(font->face().impl);
+
+			if (items->Length < size)
+			{
+				items = gcnew array<BLBlitItem>(Math::Max(size, items->Length * 2));
+			}
+
+			pending->Clear();
+			runStamp++;
+
+			// Held by the run itself, so evicting the last slots of the face
+			// while preparing does not release it.
+			auto fontEntry = AcquireFont(face, font);
+
+			try
+			{
+				return PrepareGlyphs(font, fontEntry, glyphBuffer, x, y, tx, ty, color);
+			}
+			finally
+			{
+				ReleaseFont(face);
+			}
+		}
+
+		bool PrepareGlyphs(const ::BLFont* font, FontEntry^ fontEntry, const ::BLGlyphBuffer* glyphBuffer, double x, double y, double tx, double ty, uint32_t color)
+		{
+			auto size = (int)glyphBuffer->size();
+			auto content = glyphBuffer->content();
+			auto placementData = glyphBuffer->placementData();
+			const auto& fontMatrix = font->matrix();
+
+			auto face = IntPtr(font->face().impl);
+			auto fontSize = font->size();
+
+			int64_t hitCount = 0;
+			int64_t missCount = 0;
+
+			double penX = 0.0;
+			double penY = 0.0;
+
+			for (int i = 0; i < size; i++)
+			{
+				const auto& placement = placementData[i];
+
+				auto originX = penX + placement.placement.x;
+				auto originY = penY + placement.placement.y;
+
+				auto deviceX = x + originX * fontMatrix.m00;
+				auto deviceY = y + originY * fontMatrix.m11;
+
+				penX += placement.advance.x;
+				penY += placement.advance.y;
+
+				auto pixelX = Math::Floor(deviceX);
+				auto pixelY = Math::Floor(deviceY + 0.5);
+				auto bucket = Math::Min((int)((deviceX - pixelX) * subpixelBuckets), subpixelBuckets - 1);
+
+				auto key = GlyphKey(face, fontSize, content[i], color, bucket);
+
+				GlyphSlot slot;
+
+				if (slots->TryGetValue(key, slot))
+				{
+					pageUse[slot.page] = runStamp;
+					hitCount++;
+				}
+				else
+				{
+					if (!Reserve(font, key, bucket, slot))
+					{
+						return false;
+					}
+
+					slots->Add(key, slot);
+					fontEntry->slotCount++;
+					missCount++;
+				}
+
+				items[i] = BLBlitItem(BLPoint(pixelX - slot.originX - tx, pixelY - slot.originY - ty), slot.area);
+			}
+
+			hits += hitCount;
+			misses += missCount;
+			return true;
+		}
+
+		FontEntry^ AcquireFont(IntPtr face, const ::BLFont* font)
+		{
+			FontEntry^ entry;
+
+			if (!fonts->TryGetValue(face, entry))
+			{
+				// Created outside of the object pool, which would dispose it with
+				// the current frame.
+				auto pool = BLObjectPool::Suspend();
+
+				entry = gcnew FontEntry();
+
+				try
+				{
+					entry->font = gcnew BLFont();
+				}
+				finally
+				{
+					BLObjectPool::Resume(pool);
+				}
+
+				CheckResult(blFontAssignWeak(entry->font, font));
+				fonts->Add(face, entry);
+			}
+
+			entry->slotCount++;
+			return entry;
+		}
+
+		void ReleaseFont(IntPtr face)
+		{
+			auto entry = fonts[face];
+
+			if (--entry->slotCount == 0)
+			{
+				fonts->Remove(face);
+				delete entry->font;
+			}
+		}
+
+		void RemoveSlot(GlyphKey key)
+		{
+			if (slots->Remove(key))
+			{
+				ReleaseFont(key.face);
+			}
+		}
+
+		// Removes the slots reserved by a failed Prepare, their pixels were
+		// never rendered. The space stays taken until its page is evicted.
+		void DropPending()
+		{
+			for (int i = 0; i < pending->Count; i++)
+			{
+				RemoveSlot(pending[i].key);
+			}
+
+			pending->Clear();
+		}
+
+		void ClearPages()
+		{
+			for (int i = 0; i < pages->Length; i++)
+			{
+				pages[i]->Clear();
+				pageUse[i] = 0;
+			}
+
+			for each (FontEntry^ entry in fonts->Values)
+			{
+				delete entry->font;
+			}
+
+			slots->Clear();
+			fonts->Clear();
+			pending->Clear();
+			currentPage = 0;
+		}
+
+		void EvictPage(int page)
+		{
+			pages[page]->Clear();
+
+			evicted->Clear();
+
+			for each (KeyValuePair<GlyphKey, GlyphSlot> pair in slots)
+			{
+				if (pair.Value.page == page)
+				{
+					evicted->Add(pair.Key);
+				}
+			}
+
+			for (int i = 0; i < evicted->Count; i++)
+			{
+				RemoveSlot(evicted[i]);
+			}
+
+			evicted->Clear();
+			evictions++;
+		}
+
+		// Reserves in the current page. When it is full, the least recently
+		// used page that holds no glyph of the current run is evicted and
+		// becomes the current page.
+		bool TryReserve(int width, int height, BLRectI% area)
+		{
+			if (pages[currentPage]->TryReserve(width, height, area))
+			{
+				pageUse[currentPage] = runStamp;
+				return true;
+			}
+
+			auto victim = -1;
+
+			for (int i = 0; i < pages->Length; i++)
+			{
+				if (pageUse[i] != runStamp && (victim == -1 || pageUse[i] < pageUse[victim]))
+				{
+					victim = i;
+				}
+			}
+
+			if (victim == -1)
+			{
+				return false;
+			}
+
+			EvictPage(victim);
+			currentPage = victim;
+
+			if (!pages[victim]->TryReserve(width, height, area))
+			{
+				return false;
+			}
+
+			pageUse[victim] = runStamp;
+			return true;
+		}
+
+		RunKey GetRunKey(const ::BLFont* font, const ::BLGlyphBuffer* glyphBuffer, uint32_t color)
+		{
+			auto size = glyphBuffer->size();
+			auto content = glyphBuffer->content();
+
+			uint64_t hash = 0xCBF29CE484222325ull;
+
+			for (size_t i = 0; i < size; i++)
+			{
+				hash = (hash ^ content[i]) * 0x100000001B3ull;
+			}
+
+			return RunKey(IntPtr(font->face().impl), font->size(), color, hash, (int)size);
+		}
+
+		void RememberOversized(RunKey key)
+		{
+			if (oversizedRuns->Count >= MaxOversizedRuns)
+			{
+				oversizedRuns->Clear();
+			}
+
+			oversizedRuns->Add(key);
+		}
+
+		bool Reserve(const ::BLFont* font, GlyphKey key, int bucket, GlyphSlot% slot)
+		{
+			auto glyphId = key.glyphId;
+
+			::BLBoxI bounds;
+
+			CheckResult(blFontGetGlyphBounds(font, &glyphId, sizeof(uint32_t), &bounds, 1));
+
+			slot = GlyphSlot();
+			slot.page = currentPage;
+
+			if (bounds.x0 >= bounds.x1 || bounds.y0 >= bounds.y1)
+			{
+				return true;
+			}
+
+			const auto& fontMatrix = font->matrix();
+
+			auto x0 = bounds.x0 * fontMatrix.m00;
+			auto x1 = bounds.x1 * fontMatrix.m00;
+			auto y0 = bounds.y0 * fontMatrix.m11;
+			auto y1 = bounds.y1 * fontMatrix.m11;
+
+			// One pixel of margin for antialiasing, one more on the right for
+			// the subpixel shift.
+			auto left = (int)Math::Floor(Math::Min(x0, x1)) - 1;
+			auto top = (int)Math::Floor(Math::Min(y0, y1)) - 1;
+			auto right = (int)Math::Ceiling(Math::Max(x0, x1)) + 2;
+			auto bottom = (int)Math::Ceiling(Math::Max(y0, y1)) + 1;
+
+			BLRectI area;
+
+			if (!TryReserve(right - left, bottom - top, area))
+			{
+				return false;
+			}
+
+			slot.area = area;
+			slot.originX = -left;
+			slot.originY = -top;
+			slot.page = currentPage;
+
+			PendingGlyph glyph;
+
+			glyph.key = key;
+			glyph.glyphId = glyphId;
+			glyph.x = area.X + slot.originX + (double)bucket / subpixelBuckets;
+			glyph.y = area.Y + slot.originY;
+
+			pending->Add(glyph);
+			return true;
+		}
+
+		void RenderPending(BLFont^ font, BLRgba32 color)
+		{
+			if (pending->Count == 0)
+			{
+				return;
+			}
+
+			auto context = gcnew BLContext(image);
+
+			try
+			{
+				context->SetFillStyle(color);
+
+				for (int i = 0; i < pending->Count; i++)
+				{
+					auto glyph = pending[i];
+					auto glyphId = glyph.glyphId;
+					auto origin = ::BLPoint(glyph.x, glyph.y);
+
+					::BLGlyphRun glyphRun = {};
+
+					glyphRun.glyphData = &glyphId;
+					glyphRun.glyphSize = sizeof(uint32_t);
+					glyphRun.glyphAdvance = int8_t(sizeof(uint32_t));
+					glyphRun.size = 1;
+
+					CheckResult(blContextFillGlyphRunD(context, &origin, font, &glyphRun));
+				}
+
+				context->End();
+			}
+			finally
+			{
+				delete context;
+			}
+
+			pending->Clear();
+		}
+
+		// Drops blits of empty glyphs, returns the number of remaining items.
+		int CompactItems(int size)
+		{
+			auto count = 0;
+
+			for (int i = 0; i < size; i++)
+			{
+				if (items[i].Area.Width > 0)
+				{
+					items[count++] = items[i];
+				}
+			}
+
+			return count;
+		}
+
+		void FillOutlines(BLContext^ context, BLPoint dst, BLFont^ font, BLGlyphBuffer^ glyphBuffer, BLRgba32 color)
+		{
+			context->SetFillStyle(color);
+			context->FillGlyphRun(dst, font, glyphBuffer->GlyphRun);
+
+			GC::KeepAlive(glyphBuffer);
+			fallbacks++;
+		}
+
+	public:
+
+		property BLImage^ Image
+		{
+			BLImage^ get()
+			{
+				return image;
+			}
+		}
+
+		// Optional cache of shaped text used by FillText.
+		property BLTextRunCache^ TextRunCache
+		{
+			BLTextRunCache^ get()
+			{
+				return textRunCache;
+			}
+			void set(BLTextRunCache^ value)
+			{
+				textRunCache = value;
+			}
+		}
+
+		property double MaxFontSize
+		{
+			double get()
+			{
+				return maxFontSize;
+			}
+			void set(double value)
+			{
+				if (value < 0.0)
+				{
+					throw gcnew ArgumentOutOfRangeException("value");
+				}
+
+				maxFontSize = value;
+			}
+		}
+
+		property int SubpixelBuckets
+		{
+			int get()
+			{
+				return subpixelBuckets;
+			}
+		}
+
+		// Number of glyph variants held by the atlas.
+		property int Count
+		{
+			int get()
+			{
+				return slots->Count;
+			}
+		}
+
+		property double Occupancy
+		{
+			double get()
+			{
+				auto used = 0.0;
+
+				for (int i = 0; i < pages->Length; i++)
+				{
+					used += pages[i]->Occupancy * pages[i]->Width * pages[i]->Height;
+				}
+
+				return used / ((double)image->Width * image->Height);
+			}
+		}
+
+		property int64_t Hits
+		{
+			int64_t get()
+			{
+				return hits;
+			}
+		}
+
+		property int64_t Misses
+		{
+			int64_t get()
+			{
+				return misses;
+			}
+		}
+
+		// Number of texts filled as outlines instead of composed from the atlas.
+		property int64_t Fallbacks
+		{
+			int64_t get()
+			{
+				return fallbacks;
+			}
+		}
+
+		// Number of pages evicted to make room for new glyphs.
+		property int64_t Evictions
+		{
+			int64_t get()
+			{
+				return evictions;
+			}
+		}
+
+		property double HitRate
+		{
+			double get()
+			{
+				return hits + misses > 0 ? (double)hits / (hits + misses) : 0.0;
+			}
+		}
+	};
+}
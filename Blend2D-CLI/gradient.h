@@ -422,6 +422,19 @@ namespace Blend2D
 			return impl;
 		}
 
+		// Same state as a default constructed gradient, but the stop storage
+		// is kept for the next user.
+		bool Recycle() override
+		{
+			const double values[BL_GRADIENT_VALUE_COUNT] = {};
+
+			return blGradientResetStops(this) == BL_SUCCESS
+				&& blGradientSetType(this, BL_GRADIENT_TYPE_LINEAR) == BL_SUCCESS
+				&& blGradientSetValues(this, 0, values, BL_GRADIENT_VALUE_COUNT) == BL_SUCCESS
+				&& blGradientSetExtendMode(this, BL_EXTEND_MODE_PAD) == BL_SUCCESS
+				&& blGradientApplyMatrixOp(this, BL_MATRIX2D_OP_RESET, nullptr) == BL_SUCCESS;
+		}
+
 	public:
 
 		void Reset()
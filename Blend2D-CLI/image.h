@@ -2,6 +2,8 @@
 
 #include "api.h"
 #include "object.h"
+#include "geometry.h"
+#include "bytearray.h"
 
 using namespace System;
 using namespace System::Collections::Generic;
@@ -12,6 +14,146 @@ using namespace System::Diagnostics;
 
 namespace Blend2D
 {
+	//! Flags used by `BLImageInfo`.
+	[FlagsAttribute]
+	public enum class BLImageInfoFlags : UInt32
+	{
+		//! No flags.
+		None = 0,
+		//! Progressive mode.
+		Progressive = BL_IMAGE_INFO_FLAG_PROGRESSIVE,
+	};
+
+	public value struct BLImageInfo sealed
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int width;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int height;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLSize density;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint32_t flags;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int depth;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int planeCount;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t frameCount;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		String^ format;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		String^ compression;
+
+	internal:
+
+		BLImageInfo(const ::BLImageInfo& other)
+		{
+			width = other.size.w;
+			height = other.size.h;
+			density = BLSize(other.density.w, other.density.h);
+			flags = other.flags;
+			depth = other.depth;
+			planeCount = other.planeCount;
+			frameCount = other.frameCount;
+			format = gcnew String(other.format, 0, (int)strnlen(other.format, sizeof(other.format)));
+			compression = gcnew String(other.compression, 0, (int)strnlen(other.compression, sizeof(other.compression)));
+		}
+
+	public:
+
+		String^ ToString() override
+		{
+			return String::Format("Width={0}, Height={1}, Depth={2}, Format={3}", width, height, depth, format);
+		}
+
+	public:
+
+		property int Width
+		{
+			int get()
+			{
+				return width;
+			}
+		}
+
+		property int Height
+		{
+			int get()
+			{
+				return height;
+			}
+		}
+
+		// Pixels per meter.
+		property BLSize Density
+		{
+			BLSize get()
+			{
+				return density;
+			}
+		}
+
+		property BLImageInfoFlags Flags
+		{
+			BLImageInfoFlags get()
+			{
+				return (BLImageInfoFlags)flags;
+			}
+		}
+
+		property int Depth
+		{
+			int get()
+			{
+				return depth;
+			}
+		}
+
+		property int PlaneCount
+		{
+			int get()
+			{
+				return planeCount;
+			}
+		}
+
+		// Zero when the codec does not know the number of frames.
+		property uint64_t FrameCount
+		{
+			uint64_t get()
+			{
+				return frameCount;
+			}
+		}
+
+		property String^ Format
+		{
+			String^ get()
+			{
+				return format;
+			}
+		}
+
+		property String^ Compression
+		{
+			String^ get()
+			{
+				return compression;
+			}
+		}
+	};
+
 	public ref class BLImageCodec sealed : public BLObject
 	{
 	private:
@@ -30,7 +172,7 @@ namespace Blend2D
 		{
 		}
 
-	private:
+	internal:
 
 		BLImageCodec(const ImplType& other)
 			: BLObject()
@@ -66,6 +208,54 @@ namespace Blend2D
 			CheckResult(blImageCodecFindByExtension(this, str, name->Length, nullptr));;
 		}
 
+		// Selects the built-in codec recognizing the signature at the start of
+		// data, only the first bytes are inspected.
+		void FindByData(array<Byte>^ data)
+		{
+			FindByData(data, 0, data != nullptr ? data->Length : 0);
+		}
+
+		void FindByData(array<Byte>^ data, int index, int count)
+		{
+			CheckArrayRange(data, index, count);
+
+			if (count == 0)
+			{
+				CheckResult(blImageCodecFindByData(this, nullptr, 0, nullptr));
+				return;
+			}
+
+			Pin(Byte, pData, data[index]);
+
+			CheckResult(blImageCodecFindByData(this, pData, count, nullptr));
+		}
+
+		void FindByData(const uint8_t* data, size_t size)
+		{
+			CheckResult(blImageCodecFindByData(this, data, size, nullptr));
+		}
+
+		// Returns how confident this codec is that data is in its format,
+		// zero means not at all.
+		uint32_t InspectData(array<Byte>^ data, int index, int count)
+		{
+			CheckArrayRange(data, index, count);
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			Pin(Byte, pData, data[index]);
+
+			return blImageCodecInspectData(this, pData, count);
+		}
+
+		uint32_t InspectData(const uint8_t* data, size_t size)
+		{
+			return blImageCodecInspectData(this, data, size);
+		}
+
 	public:
 
 		static List<BLImageCodec^>^ BuiltInCodecs()
@@ -138,6 +328,9 @@ namespace Blend2D
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
 		HBITMAP oldBitmap = nullptr;
 
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLImage^ viewSource = nullptr;
+
 	internal:
 
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
@@ -166,6 +359,8 @@ namespace Blend2D
 			: BLObject()
 		{
 			CheckResult(blImageInitAs(this, width, height, (uint32_t)format));
+
+			ReportMemoryPressure();
 		}
 
 	internal:
@@ -176,6 +371,28 @@ namespace Blend2D
 			InitFromControl(control);
 		}
 
+		BLImage(Control^ control, int width, int height)
+			: BLObject()
+		{
+			InitFromControl(control, width, height);
+		}
+
+		// Creates an image that shares the top-left width x height pixels of
+		// source (including its device context) without copying them.
+		BLImage(BLImage^ source, int width, int height)
+			: BLObject()
+		{
+			if (width > source->Width || height > source->Height)
+			{
+				throw gcnew ArgumentOutOfRangeException("width");
+			}
+
+			CheckResult(blImageCreateFromData(this, width, height, (uint32_t)source->Format, (void*)source->PixelData, source->Stride, nullptr, nullptr));
+
+			viewSource = source;
+			hdc = source->hdc;
+		}
+
 	internal:
 
 		operator ImplType* ()
@@ -192,6 +409,13 @@ namespace Blend2D
 
 		void Destroy() override
 		{
+			if (viewSource != nullptr)
+			{
+				viewSource = nullptr;
+				hdc = nullptr;
+				return;
+			}
+
 			if (sourceBitmap != nullptr && sourceData != nullptr)
 			{
 				sourceBitmap->UnlockBits(sourceData);
@@ -234,11 +458,75 @@ namespace Blend2D
 			CheckResult(blImageWriteToFile(this, str, codec));
 		}
 
+		// Encodes the image into destination, replacing its content. The
+		// capacity of destination is reused, keep one per thread to encode
+		// without allocations.
+		void WriteToData(BLByteArray^ destination, BLImageCodec^ codec)
+		{
+			if (destination == nullptr)
+			{
+				throw gcnew ArgumentNullException("destination");
+			}
+
+			if (codec == nullptr)
+			{
+				throw gcnew ArgumentNullException("codec");
+			}
+
+			CheckResult(blImageWriteToData(this, destination, codec));
+
+			destination->UpdateMemoryPressure();
+		}
+
 		void ReadFromFile(String^ fileName)
 		{
 			ConvertChar(str, fileName);
 
 			CheckResult(blImageReadFromFile(this, str, nullptr));
+
+			ReportMemoryPressure();
+		}
+
+		// Decodes an encoded image held in memory with the built-in codec that
+		// recognizes it. Data is read in place, nothing is copied.
+		void ReadFromData(array<Byte>^ data)
+		{
+			ReadFromData(data, 0, data != nullptr ? data->Length : 0);
+		}
+
+		void ReadFromData(array<Byte>^ data, int index, int count)
+		{
+			CheckArrayRange(data, index, count);
+
+			if (count == 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("count");
+			}
+
+			Pin(Byte, pData, data[index]);
+
+			ReadFromData(pData, count);
+		}
+
+		void ReadFromData(const uint8_t* data, size_t size)
+		{
+			CheckResult(blImageReadFromData(this, data, size, nullptr));
+
+			ReportMemoryPressure();
+		}
+
+	internal:
+
+		void ReportMemoryPressure()
+		{
+			// Pixels of a locked Bitmap are owned by GDI+, not by this image.
+			if (sourceBitmap != nullptr || viewSource != nullptr)
+			{
+				SetMemoryPressure(0);
+				return;
+			}
+
+			SetMemoryPressure(Math::Abs((int64_t)Stride) * Height);
 		}
 
 	private:
@@ -268,11 +556,14 @@ namespace Blend2D
 		}
 
 		void InitFromControl(Control^ control)
+		{
+			InitFromControl(control, control->Width, control->Height);
+		}
+
+		void InitFromControl(Control^ control, int width, int height)
 		{
 			auto hwnd = (HWND)control->Handle.ToPointer();
 			auto source = GetDC(hwnd);
-			auto width = control->Width;
-			auto height = control->Height;
 			auto stride = width * 4;
 
 			try
@@ -296,6 +587,8 @@ namespace Blend2D
 					oldBitmap = (HBITMAP)SelectObject(hdc, bitmap);
 
 					CheckResult(blImageCreateFromData(this, width, height, (uint32_t)BLFormat::PRGB32, lpBitmapBits, stride, nullptr, nullptr));
+
+					ReportMemoryPressure();
 				}
 				else
 				{
@@ -379,4 +672,258 @@ namespace Blend2D
 			}
 		}
 	};
+
+	// Decodes images frame by frame from memory. Data passed to ReadInfo and
+	// ReadFrame is read in place; for a multi-frame image pass the same
+	// buffer on every call, the decoder keeps its position in BufferIndex.
+	public ref class BLImageDecoder sealed : public BLObject
+	{
+	private:
+
+		typedef ::BLImageDecoder ImplType;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<ImplType> impl;
+
+	public:
+
+		BLImageDecoder(BLImageCodec^ codec)
+			: BLObject()
+		{
+			if (codec == nullptr)
+			{
+				throw gcnew ArgumentNullException("codec");
+			}
+
+			CheckResult(blImageCodecCreateDecoder(codec, this));
+		}
+
+	internal:
+
+		operator ImplType* ()
+		{
+			if (Object::ReferenceEquals(this, nullptr))
+			{
+				return nullptr;
+			}
+
+			return impl;
+		}
+
+	public:
+
+		// Creates a decoder for the codec recognizing data.
+		static BLImageDecoder^ FromData(array<Byte>^ data)
+		{
+			auto codec = gcnew BLImageCodec();
+
+			try
+			{
+				codec->FindByData(data);
+
+				return gcnew BLImageDecoder(codec);
+			}
+			finally
+			{
+				delete codec;
+			}
+		}
+
+		void Restart()
+		{
+			CheckResult(blImageDecoderRestart(this));
+		}
+
+		BLImageInfo ReadInfo(array<Byte>^ data)
+		{
+			return ReadInfo(data, 0, data != nullptr ? data->Length : 0);
+		}
+
+		BLImageInfo ReadInfo(array<Byte>^ data, int index, int count)
+		{
+			CheckArrayRange(data, index, count);
+
+			if (count == 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("count");
+			}
+
+			Pin(Byte, pData, data[index]);
+
+			return ReadInfo(pData, count);
+		}
+
+		BLImageInfo ReadInfo(const uint8_t* data, size_t size)
+		{
+			::BLImageInfo info;
+
+			CheckResult(blImageDecoderReadInfo(this, &info, data, size));
+
+			return BLImageInfo(info);
+		}
+
+		void ReadFrame(BLImage^ image, array<Byte>^ data)
+		{
+			ReadFrame(image, data, 0, data != nullptr ? data->Length : 0);
+		}
+
+		void ReadFrame(BLImage^ image, array<Byte>^ data, int index, int count)
+		{
+			CheckArrayRange(data, index, count);
+
+			if (count == 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("count");
+			}
+
+			Pin(Byte, pData, data[index]);
+
+			ReadFrame(image, pData, count);
+		}
+
+		void ReadFrame(BLImage^ image, const uint8_t* data, size_t size)
+		{
+			if (image == nullptr)
+			{
+				throw gcnew ArgumentNullException("image");
+			}
+
+			CheckResult(blImageDecoderReadFrame(this, image, data, size));
+
+			image->ReportMemoryPressure();
+		}
+
+	public:
+
+		property BLImageCodec^ Codec
+		{
+			BLImageCodec^ get()
+			{
+				return gcnew BLImageCodec(impl->impl->codec);
+			}
+		}
+
+		property BLResultCode LastResult
+		{
+			BLResultCode get()
+			{
+				return (BLResultCode)impl->lastResult();
+			}
+		}
+
+		property uint64_t FrameIndex
+		{
+			uint64_t get()
+			{
+				return impl->frameIndex();
+			}
+		}
+
+		property size_t BufferIndex
+		{
+			size_t get()
+			{
+				return impl->bufferIndex();
+			}
+		}
+	};
+
+	// Encodes images into memory. WriteFrame replaces the content of its
+	// destination, which keeps its capacity between calls.
+	public ref class BLImageEncoder sealed : public BLObject
+	{
+	private:
+
+		typedef ::BLImageEncoder ImplType;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<ImplType> impl;
+
+	public:
+
+		BLImageEncoder(BLImageCodec^ codec)
+			: BLObject()
+		{
+			if (codec == nullptr)
+			{
+				throw gcnew ArgumentNullException("codec");
+			}
+
+			CheckResult(blImageCodecCreateEncoder(codec, this));
+		}
+
+	internal:
+
+		operator ImplType* ()
+		{
+			if (Object::ReferenceEquals(this, nullptr))
+			{
+				return nullptr;
+			}
+
+			return impl;
+		}
+
+	public:
+
+		void Restart()
+		{
+			CheckResult(blImageEncoderRestart(this));
+		}
+
+		void WriteFrame(BLByteArray^ destination, BLImage^ image)
+		{
+			if (destination == nullptr)
+			{
+				throw gcnew ArgumentNullException("destination");
+			}
+
+			if (image == nullptr)
+			{
+				throw gcnew ArgumentNullException("image");
+			}
+
+			CheckResult(blImageEncoderWriteFrame(this, destination, image));
+
+			destination->UpdateMemoryPressure();
+		}
+
+	public:
+
+		property BLImageCodec^ Codec
+		{
+			BLImageCodec^ get()
+			{
+				return gcnew BLImageCodec(impl->impl->codec);
+			}
+		}
+
+		property BLResultCode LastResult
+		{
+			BLResultCode get()
+			{
+				return (BLResultCode)impl->lastResult();
+			}
+		}
+
+		property uint64_t FrameIndex
+		{
+			uint64_t get()
+			{
+				return impl->frameIndex();
+			}
+		}
+
+		property size_t BufferIndex
+		{
+			size_t get()
+			{
+				return impl->bufferIndex();
+			}
+		}
+	};
 }
\ No newline at end of file
@@ -0,0 +1,338 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "geometry.h"
+#include "matrix.h"
+#include "image.h"
+#include "context.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+
+namespace Blend2D
+{
+	// Offscreen PRGB32 image holding content that rarely changes. The render
+	// callback only runs when the layer was invalidated or its size, scale or
+	// matrix changed; otherwise Draw just blits the cached image.
+	public ref class BLLayer sealed
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Action<BLContext^>^ render;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLImage^ image = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int width;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int height;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		double scale = 1.0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLMatrix2D matrix = BLMatrix2D(1.0, 0.0, 0.0, 1.0, 0.0, 0.0);
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLCompOp compOp = BLCompOp::SourceOver;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool dirty = true;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t hitCount = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t renderCount = 0;
+
+	public:
+
+		BLLayer(int width, int height, Action<BLContext^>^ render)
+		{
+			if (render == nullptr)
+			{
+				throw gcnew ArgumentNullException("render");
+			}
+
+			if (width < 0 || height < 0)
+			{
+				throw gcnew ArgumentOutOfRangeException(width < 0 ? "width" : "height");
+			}
+
+			this->width = width;
+			this->height = height;
+			this->render = render;
+		}
+
+		~BLLayer()
+		{
+			ReleaseImage();
+		}
+
+	public:
+
+		void Invalidate()
+		{
+			dirty = true;
+		}
+
+		void Resize(int width, int height)
+		{
+			if (width < 0 || height < 0)
+			{
+				throw gcnew ArgumentOutOfRangeException(width < 0 ? "width" : "height");
+			}
+
+			if (width != this->width || height != this->height)
+			{
+				this->width = width;
+				this->height = height;
+				dirty = true;
+			}
+		}
+
+		// Renders the layer if it is dirty. Returns true when it was rendered.
+		bool Update()
+		{
+			if (!dirty)
+			{
+				hitCount++;
+				return false;
+			}
+
+			auto pixelWidth = PixelWidth;
+			auto pixelHeight = PixelHeight;
+
+			if (pixelWidth == 0 || pixelHeight == 0)
+			{
+				ReleaseImage();
+				dirty = false;
+				return false;
+			}
+
+			if (image == nullptr || image->Width != pixelWidth || image->Height != pixelHeight)
+			{
+				ReleaseImage();
+
+				// Updates usually run inside a paint pool, the image has to
+				// survive it.
+				auto pool = BLObjectPool::Suspend();
+
+				try
+				{
+					image = gcnew BLImage(pixelWidth, pixelHeight, BLFormat::PRGB32);
+				}
+				finally
+				{
+					BLObjectPool::Resume(pool);
+				}
+			}
+
+			auto context = gcnew BLContext(image);
+
+			try
+			{
+				context->ClearAll();
+				context->Scale(scale);
+				context->Transform(matrix);
+				context->UserToMeta();
+
+				render(context);
+
+				context->End();
+			}
+			finally
+			{
+				delete context;
+			}
+
+			dirty = false;
+			renderCount++;
+			return true;
+		}
+
+		// Updates the layer when needed and composes it at position (in the
+		// current user coordinates of context) with a single blit.
+		void Draw(BLContext^ context, BLPoint position)
+		{
+			Update();
+
+			if (image == nullptr)
+			{
+				return;
+			}
+
+			auto previous = context->CompOp;
+
+			context->CompOp = compOp;
+
+			try
+			{
+				if (scale == 1.0)
+				{
+					context->BlitImage(position, image);
+				}
+				else
+				{
+					context->BlitImage(BLRect(position.X, position.Y, width, height), image);
+				}
+			}
+			finally
+			{
+				context->CompOp = previous;
+			}
+		}
+
+		void Draw(BLContext^ context)
+		{
+			Draw(context, BLPoint(0, 0));
+		}
+
+	private:
+
+		void ReleaseImage()
+		{
+			if (image != nullptr)
+			{
+				delete image;
+				image = nullptr;
+			}
+		}
+
+		static bool SameMatrix(BLMatrix2D a, BLMatrix2D b)
+		{
+			return a.M00 == b.M00 && a.M01 == b.M01 && a.M10 == b.M10 && a.M11 == b.M11 && a.M20 == b.M20 && a.M21 == b.M21;
+		}
+
+	public:
+
+		property int Width
+		{
+			int get()
+			{
+				return width;
+			}
+		}
+
+		property int Height
+		{
+			int get()
+			{
+				return height;
+			}
+		}
+
+		property int PixelWidth
+		{
+			int get()
+			{
+				return (int)Math::Ceiling(width * scale);
+			}
+		}
+
+		property int PixelHeight
+		{
+			int get()
+			{
+				return (int)Math::Ceiling(height * scale);
+			}
+		}
+
+		// Device pixels per layer unit, the cached image is allocated at this
+		// resolution and scaled back by Draw.
+		property double Scale
+		{
+			double get()
+			{
+				return scale;
+			}
+			void set(double value)
+			{
+				if (!(value > 0.0))
+				{
+					throw gcnew ArgumentOutOfRangeException("value");
+				}
+
+				if (value != scale)
+				{
+					scale = value;
+					dirty = true;
+				}
+			}
+		}
+
+		// Matrix applied to the content before the render callback runs.
+		property BLMatrix2D Matrix
+		{
+			BLMatrix2D get()
+			{
+				return matrix;
+			}
+			void set(BLMatrix2D value)
+			{
+				if (!SameMatrix(value, matrix))
+				{
+					matrix = value;
+					dirty = true;
+				}
+			}
+		}
+
+		property BLCompOp CompOp
+		{
+			BLCompOp get()
+			{
+				return compOp;
+			}
+			void set(BLCompOp value)
+			{
+				compOp = value;
+			}
+		}
+
+		property bool IsDirty
+		{
+			bool get()
+			{
+				return dirty;
+			}
+		}
+
+		property BLImage^ Image
+		{
+			BLImage^ get()
+			{
+				return image;
+			}
+		}
+
+		// Number of Update calls served from the cached image.
+		property int64_t CacheHits
+		{
+			int64_t get()
+			{
+				return hitCount;
+			}
+		}
+
+		property int64_t RenderCount
+		{
+			int64_t get()
+			{
+				return renderCount;
+			}
+		}
+
+		property int64_t BytesHeld
+		{
+			int64_t get()
+			{
+				return image != nullptr ? Math::Abs((int64_t)image->Stride) * image->Height : 0;
+			}
+		}
+	};
+}
@@ -10,4 +10,4 @@ namespace Blend2D
 	{
 		BLObjectPool::Add(this);
 	}
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "api.h"
+#include "allocator.h"
 
 using namespace System;
 using namespace System::Diagnostics;
@@ -9,6 +10,16 @@ using namespace System::Threading;
 
 namespace Blend2D
 {
+#pragma managed(push, off)
+
+	template <typename T>
+	void DestroyCore(void* core)
+	{
+		static_cast<T*>(core)->~T();
+	}
+
+#pragma managed(pop)
+
 	template <typename T>
 	private ref class BLObjectPointer sealed
 	{
@@ -20,21 +31,36 @@ namespace Blend2D
 
 		BLObjectPointer()
 		{
-			target = new T();
+			static_assert(alignof(T) <= MEMORY_ALLOCATION_ALIGNMENT, "core alignment exceeds allocator alignment");
+
+			void* block = AllocCore(sizeof(T));
+
+			if (block == nullptr)
+			{
+				throw gcnew OutOfMemoryException();
+			}
+
+			target = new (block) T();
 		}
 
 		~BLObjectPointer()
 		{
-			BLObjectPointer::!BLObjectPointer();
+			if (target != nullptr)
+			{
+				target->~T();
+				FreeCore(target, sizeof(T));
+				target = nullptr;
+			}
 		}
 
 	protected:
 
+		// Finalizers only queue the core, the native release thread destroys it.
 		!BLObjectPointer()
 		{
 			if (target != nullptr)
 			{
-				delete target;
+				ReleaseCoreDeferred(target, sizeof(T), &DestroyCore<T>);
 				target = nullptr;
 			}
 		}
@@ -54,12 +80,24 @@ namespace Blend2D
 
 	public ref class BLObject abstract
 	{
+	private:
+
+		// Changes below this size are not worth a call into the GC.
+		literal int64_t MemoryPressureGranularity = 64 * 1024;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t memoryPressure = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool disposed = false;
+
 	internal:
 
 		BLObject();
 
 		~BLObject()
 		{
+			disposed = true;
 			BLObject::!BLObject();
 		}
 
@@ -68,6 +106,7 @@ namespace Blend2D
 		!BLObject()
 		{
 			Destroy();
+			SetMemoryPressure(0);
 		}
 
 	protected:
@@ -75,6 +114,103 @@ namespace Blend2D
 		virtual void Destroy()
 		{
 		}
+
+	internal:
+
+		// Returns the object to its default state so BLObjectPool can rent it
+		// again. Objects that cannot be reused return false and are disposed.
+		virtual bool Recycle()
+		{
+			return false;
+		}
+
+		property bool IsDisposed
+		{
+			bool get()
+			{
+				return disposed;
+			}
+		}
+
+		// Reports the native bytes owned by this object to the GC.
+		void SetMemoryPressure(int64_t bytes)
+		{
+			if (bytes != 0 && Math::Abs(bytes - memoryPressure) < MemoryPressureGranularity)
+			{
+				return;
+			}
+
+			if (bytes > memoryPressure)
+			{
+				GC::AddMemoryPressure(bytes - memoryPressure);
+			}
+			else if (bytes < memoryPressure)
+			{
+				GC::RemoveMemoryPressure(memoryPressure - bytes);
+			}
+
+			memoryPressure = bytes;
+		}
+	};
+
+	public ref class BLCoreAllocator abstract sealed
+	{
+	public:
+
+		static property int64_t AllocationCount
+		{
+			int64_t get()
+			{
+				BLCoreAllocatorStats stats;
+				GetCoreAllocatorStats(&stats);
+
+				return stats.allocationCount;
+			}
+		}
+
+		static property int64_t LiveCount
+		{
+			int64_t get()
+			{
+				BLCoreAllocatorStats stats;
+				GetCoreAllocatorStats(&stats);
+
+				return stats.liveCount;
+			}
+		}
+
+		static property int64_t SlabCount
+		{
+			int64_t get()
+			{
+				BLCoreAllocatorStats stats;
+				GetCoreAllocatorStats(&stats);
+
+				return stats.slabCount;
+			}
+		}
+
+		static property int64_t HeapAllocationCount
+		{
+			int64_t get()
+			{
+				BLCoreAllocatorStats stats;
+				GetCoreAllocatorStats(&stats);
+
+				return stats.heapAllocationCount;
+			}
+		}
+
+		static property int64_t PendingReleaseCount
+		{
+			int64_t get()
+			{
+				BLCoreAllocatorStats stats;
+				GetCoreAllocatorStats(&stats);
+
+				return stats.pendingReleaseCount;
+			}
+		}
 	};
 
 	public ref class BLObjectPool sealed
@@ -86,18 +222,22 @@ namespace Blend2D
 
 		Stack<BLObject^>^ stack;
 
+		List<BLObject^>^ rented = nullptr;
+
+		Dictionary<Type^, Stack<BLObject^>^>^ freeLists = nullptr;
+
+		bool skipNextAdd = false;
+
 	public:
 
 		BLObjectPool()
 		{
-			stack = gcnew Stack<BLObject^>();
-
-			if (current != nullptr)
-			{
-				throw gcnew InvalidOperationException("ivalid pool state");
-			}
+			Init(false);
+		}
 
-			current = this;
+		BLObjectPool(bool frameArena)
+		{
+			Init(frameArena);
 		}
 
 		~BLObjectPool()
@@ -113,21 +253,159 @@ namespace Blend2D
 			DisposeItems();
 		}
 
+	public:
+
+		// Ends a frame of a frame arena pool. Rented objects are recycled and
+		// handed out again by Rent, everything else created since the previous
+		// frame is disposed.
+		void EndFrame()
+		{
+			if (rented == nullptr)
+			{
+				throw gcnew InvalidOperationException("pool is not a frame arena");
+			}
+
+			for each (BLObject^ item in rented)
+			{
+				// Items disposed by their user have no core left to recycle.
+				if (item->IsDisposed)
+				{
+					continue;
+				}
+
+				if (item->Recycle())
+				{
+					GetFreeList(item->GetType())->Push(item);
+				}
+				else
+				{
+					delete item;
+				}
+			}
+
+			rented->Clear();
+
+			DisposeStack(stack);
+		}
+
+		generic <typename T> where T : BLObject, gcnew()
+		static T Rent()
+		{
+			auto pool = current;
+
+			if (pool == nullptr || pool->rented == nullptr)
+			{
+				return gcnew T();
+			}
+
+			T item;
+			Stack<BLObject^>^ freeList;
+
+			if (pool->freeLists->TryGetValue(T::typeid, freeList))
+			{
+				while (freeList->Count > 0 && item == nullptr)
+				{
+					item = safe_cast<T>(freeList->Pop());
+
+					// References kept past EndFrame can still dispose free items.
+					if (item->IsDisposed)
+					{
+						item = nullptr;
+					}
+				}
+			}
+
+			if (item == nullptr)
+			{
+				pool->skipNextAdd = true;
+
+				try
+				{
+					item = gcnew T();
+				}
+				finally
+				{
+					pool->skipNextAdd = false;
+				}
+			}
+
+			pool->rented->Add(item);
+			return item;
+		}
+
 	private:
 
+		void Init(bool frameArena)
+		{
+			stack = gcnew Stack<BLObject^>();
+
+			if (frameArena)
+			{
+				rented = gcnew List<BLObject^>();
+				freeLists = gcnew Dictionary<Type^, Stack<BLObject^>^>();
+			}
+
+			if (current != nullptr)
+			{
+				throw gcnew InvalidOperationException("ivalid pool state");
+			}
+
+			current = this;
+		}
+
+		Stack<BLObject^>^ GetFreeList(Type^ type)
+		{
+			Stack<BLObject^>^ freeList;
+
+			if (!freeLists->TryGetValue(type, freeList))
+			{
+				freeList = gcnew Stack<BLObject^>();
+				freeLists->Add(type, freeList);
+			}
+
+			return freeList;
+		}
+
+		static void DisposeStack(Stack<BLObject^>^ items)
+		{
+			while (items->Count > 0)
+			{
+				auto current = items->Pop();
+				delete current;
+			}
+		}
+
 		void DisposeItems()
 		{
 			if (stack != nullptr)
 			{
-				while (stack->Count > 0)
-				{
-					auto current = stack->Pop();
-					delete current;
-				}
+				DisposeStack(stack);
 
 				delete stack;
 				stack = nullptr;
 			}
+
+			if (rented != nullptr)
+			{
+				for each (BLObject^ item in rented)
+				{
+					delete item;
+				}
+
+				delete rented;
+				rented = nullptr;
+			}
+
+			if (freeLists != nullptr)
+			{
+				for each (Stack<BLObject^>^ freeList in freeLists->Values)
+				{
+					DisposeStack(freeList);
+				}
+
+				delete freeLists;
+				freeLists = nullptr;
+			}
 		}
 
 	internal:
@@ -136,8 +414,30 @@ namespace Blend2D
 		{
 			if (current != nullptr)
 			{
+				if (current->skipNextAdd)
+				{
+					current->skipNextAdd = false;
+					return;
+				}
+
 				current->stack->Push(item);
 			}
 		}
+
+		// Objects created between Suspend and Resume are not added to the pool
+		// of the calling thread. Caches use it for objects that outlive the
+		// pool scope they happen to be created in.
+		static BLObjectPool^ Suspend()
+		{
+			auto pool = current;
+			current = nullptr;
+
+			return pool;
+		}
+
+		static void Resume(BLObjectPool^ pool)
+		{
+			current = pool;
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "pch.h"
+#include "api.h"
+#include "path.h"
+
+// Raw path data is validated and copied in native code, so appending a whole
+// buffer costs a single managed/native transition. Content hashes used by the
+// stroke cache are computed here as well.
+#pragma managed(push, off)
+
+namespace Blend2D
+{
+	// Every figure has to start with MOVE, segments and CLOSE need a current
+	// point. The data continues the path, so it may begin with segments when
+	// the path ends in an open figure.
+	static bool ValidatePathCommands(const uint8_t* commands, size_t count, bool hasCurrentPoint)
+	{
+		size_t i = 0;
+
+		while (i < count)
+		{
+			if (commands[i] != BL_PATH_CMD_MOVE && !hasCurrentPoint)
+			{
+				return false;
+			}
+
+			switch (commands[i])
+			{
+			case BL_PATH_CMD_MOVE:
+				hasCurrentPoint = true;
+				i++;
+				break;
+
+			case BL_PATH_CMD_ON:
+				i++;
+				break;
+
+			case BL_PATH_CMD_CLOSE:
+				hasCurrentPoint = false;
+				i++;
+				break;
+
+			case BL_PATH_CMD_QUAD:
+				if (count - i < 2 || commands[i + 1] != BL_PATH_CMD_ON)
+				{
+					return false;
+				}
+
+				i += 2;
+				break;
+
+			case BL_PATH_CMD_CUBIC:
+				if (count - i < 3 || commands[i + 1] != BL_PATH_CMD_CUBIC || commands[i + 2] != BL_PATH_CMD_ON)
+				{
+					return false;
+				}
+
+				i += 3;
+				break;
+
+			default:
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	BLResult AppendPathData(BLPathCore* self, const uint8_t* commands, const ::BLPoint* vertices, size_t count)
+	{
+		if (count == 0)
+		{
+			return BL_SUCCESS;
+		}
+
+		auto path = static_cast<const ::BLPath*>(self);
+		size_t size = path->size();
+		bool hasCurrentPoint = size > 0 && path->commandData()[size - 1] != BL_PATH_CMD_CLOSE;
+
+		if (!ValidatePathCommands(commands, count, hasCurrentPoint))
+		{
+			return BL_ERROR_INVALID_GEOMETRY;
+		}
+
+		uint8_t* cmdData;
+		::BLPoint* vtxData;
+
+		BLResult result = blPathModifyOp(self, BL_MODIFY_OP_APPEND_GROW, count, &cmdData, &vtxData);
+
+		if (result != BL_SUCCESS)
+		{
+			return result;
+		}
+
+		memcpy(cmdData, commands, count);
+		memcpy(vtxData, vertices, count * sizeof(::BLPoint));
+
+		return BL_SUCCESS;
+	}
+
+	static const uint64_t HashSeed = 0xCBF29CE484222325ull;
+	static const uint64_t HashMultiplier = 0x9E3779B97F4A7C15ull;
+
+	static uint64_t HashWord(uint64_t hash, uint64_t word)
+	{
+		hash = (hash ^ word) * HashMultiplier;
+		return hash ^ (hash >> 29);
+	}
+
+	static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		auto p = static_cast<const uint8_t*>(data);
+
+		for (; size >= 8; p += 8, size -= 8)
+		{
+			uint64_t word;
+			memcpy(&word, p, 8);
+			hash = HashWord(hash, word);
+		}
+
+		uint64_t tail = 0;
+
+		if (size > 0)
+		{
+			memcpy(&tail, p, size);
+		}
+
+		return HashWord(hash, tail ^ (uint64_t(size) << 56));
+	}
+
+	uint64_t HashPathData(const BLPathCore* self)
+	{
+		auto path = static_cast<const ::BLPath*>(self);
+		size_t size = path->size();
+
+		uint64_t hash = HashWord(HashSeed, size);
+		hash = HashBytes(hash, path->commandData(), size);
+		hash = HashBytes(hash, path->vertexData(), size * sizeof(::BLPoint));
+
+		return hash;
+	}
+
+	uint64_t HashStrokeParams(const BLStrokeOptionsCore* options, const ::BLApproximationOptions* approximationOptions, double scale)
+	{
+		uint64_t hash = HashSeed;
+
+		hash = HashWord(hash, options->hints);
+		hash = HashBytes(hash, &options->width, sizeof(double));
+		hash = HashBytes(hash, &options->miterLimit, sizeof(double));
+		hash = HashBytes(hash, &options->dashOffset, sizeof(double));
+		hash = HashWord(hash, options->dashArray.size());
+		hash = HashBytes(hash, options->dashArray.data(), options->dashArray.size() * sizeof(double));
+		hash = HashBytes(hash, approximationOptions, sizeof(::BLApproximationOptions));
+		hash = HashBytes(hash, &scale, sizeof(double));
+
+		return hash;
+	}
+
+	// Compares the same bytes HashStrokeParams hashes, so equal parameters
+	// always hash equally.
+	bool StrokeParamsEqual(const BLStrokeOptionsCore* a, const ::BLApproximationOptions* approximationA, const BLStrokeOptionsCore* b, const ::BLApproximationOptions* approximationB)
+	{
+		size_t dashCount = a->dashArray.size();
+
+		return a->hints == b->hints
+			&& memcmp(&a->width, &b->width, sizeof(double)) == 0
+			&& memcmp(&a->miterLimit, &b->miterLimit, sizeof(double)) == 0
+			&& memcmp(&a->dashOffset, &b->dashOffset, sizeof(double)) == 0
+			&& dashCount == b->dashArray.size()
+			&& (dashCount == 0 || memcmp(a->dashArray.data(), b->dashArray.data(), dashCount * sizeof(double)) == 0)
+			&& memcmp(approximationA, approximationB, sizeof(::BLApproximationOptions)) == 0;
+	}
+}
+
+#pragma managed(pop)
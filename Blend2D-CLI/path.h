@@ -271,6 +271,11 @@ namespace Blend2D
 			return impl;
 		}
 
+		bool Recycle() override
+		{
+			return blStrokeOptionsReset(this) == BL_SUCCESS;
+		}
+
 	public:
 
 		void Reset()
@@ -370,6 +375,410 @@ namespace Blend2D
 		}
 	};
 
+	extern BLResult AppendPathData(BLPathCore* self, const uint8_t* commands, const ::BLPoint* vertices, size_t count);
+	extern uint64_t HashPathData(const BLPathCore* self);
+	extern uint64_t HashStrokeParams(const BLStrokeOptionsCore* options, const ::BLApproximationOptions* approximationOptions, double scale);
+	extern bool StrokeParamsEqual(const BLStrokeOptionsCore* a, const ::BLApproximationOptions* approximationA, const BLStrokeOptionsCore* b, const ::BLApproximationOptions* approximationB);
+
+	ref class BLPath;
+
+	//! Path segment type decoded by `BLPathSegmentIterator`.
+	public enum class BLPathSegmentType : UInt32
+	{
+		//! Start of a new figure at P0.
+		Move = 0,
+		//! Line from P0 to P1.
+		Line = 1,
+		//! Quadratic curve from P0 to P2 with control point P1.
+		Quad = 2,
+		//! Cubic curve from P0 to P3 with control points P1 and P2.
+		Cubic = 3,
+		//! Figure closed from P0 back to its start point P1.
+		Close = 4,
+	};
+
+	public value struct BLPathSegment sealed
+	{
+	internal:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPathSegmentType type;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPoint p0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPoint p1;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPoint p2;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPoint p3;
+
+	public:
+
+		property BLPathSegmentType Type
+		{
+			BLPathSegmentType get()
+			{
+				return type;
+			}
+		}
+
+		property BLPoint P0
+		{
+			BLPoint get()
+			{
+				return p0;
+			}
+		}
+
+		property BLPoint P1
+		{
+			BLPoint get()
+			{
+				return p1;
+			}
+		}
+
+		property BLPoint P2
+		{
+			BLPoint get()
+			{
+				return p2;
+			}
+		}
+
+		property BLPoint P3
+		{
+			BLPoint get()
+			{
+				return p3;
+			}
+		}
+	};
+
+	// Views read the native path storage directly. They become invalid as soon
+	// as the owning path is modified or disposed.
+	public value struct BLPathVertexView sealed
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPath^ owner;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t version;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		const ::BLPoint* data;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		size_t size;
+
+	internal:
+
+		BLPathVertexView(BLPath^ owner, uint64_t version, const ::BLPoint* data, size_t size)
+			: owner(owner), version(version), data(data), size(size)
+		{
+		}
+
+	private:
+
+		bool IsCurrent();
+
+		void CheckCurrent()
+		{
+			if (!IsCurrent())
+			{
+				throw gcnew InvalidOperationException("Path was modified after the view was created.");
+			}
+		}
+
+	public:
+
+		void CopyTo(array<BLPoint>^ destination, int index)
+		{
+			CheckCurrent();
+			CheckArrayRange(destination, index, (int)size);
+
+			if (size > 0)
+			{
+				Pin(BLPoint, pDestination, destination[index]);
+
+				memcpy(pDestination, data, size * sizeof(::BLPoint));
+			}
+		}
+
+	public:
+
+		property bool IsValid
+		{
+			bool get()
+			{
+				return IsCurrent();
+			}
+		}
+
+		property int Count
+		{
+			int get()
+			{
+				return (int)size;
+			}
+		}
+
+		property BLPoint default[int]
+		{
+			BLPoint get(int index)
+			{
+				CheckCurrent();
+
+				if ((size_t)index >= size)
+				{
+					throw gcnew IndexOutOfRangeException();
+				}
+
+				return BLPoint(data[index]);
+			}
+		}
+	};
+
+	public value struct BLPathCommandView sealed
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPath^ owner;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t version;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		const uint8_t* data;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		size_t size;
+
+	internal:
+
+		BLPathCommandView(BLPath^ owner, uint64_t version, const uint8_t* data, size_t size)
+			: owner(owner), version(version), data(data), size(size)
+		{
+		}
+
+	private:
+
+		bool IsCurrent();
+
+		void CheckCurrent()
+		{
+			if (!IsCurrent())
+			{
+				throw gcnew InvalidOperationException("Path was modified after the view was created.");
+			}
+		}
+
+	public:
+
+		void CopyTo(array<BLPathCommand>^ destination, int index)
+		{
+			CheckCurrent();
+			CheckArrayRange(destination, index, (int)size);
+
+			if (size > 0)
+			{
+				Pin(BLPathCommand, pDestination, destination[index]);
+
+				memcpy(pDestination, data, size);
+			}
+		}
+
+	public:
+
+		property bool IsValid
+		{
+			bool get()
+			{
+				return IsCurrent();
+			}
+		}
+
+		property int Count
+		{
+			int get()
+			{
+				return (int)size;
+			}
+		}
+
+		property BLPathCommand default[int]
+		{
+			BLPathCommand get(int index)
+			{
+				CheckCurrent();
+
+				if ((size_t)index >= size)
+				{
+					throw gcnew IndexOutOfRangeException();
+				}
+
+				return (BLPathCommand)data[index];
+			}
+		}
+	};
+
+	// Decodes path commands into segments without copying the path. Supports
+	// the foreach pattern directly, so iterating does not box.
+	public value struct BLPathSegmentIterator sealed
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPath^ owner;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t version;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		const uint8_t* commands;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		const ::BLPoint* vertices;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		size_t size;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		size_t index;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPoint position;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPoint figureStart;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPathSegment current;
+
+	internal:
+
+		BLPathSegmentIterator(BLPath^ owner, uint64_t version, const uint8_t* commands, const ::BLPoint* vertices, size_t size)
+			: owner(owner), version(version), commands(commands), vertices(vertices), size(size), index(0)
+		{
+		}
+
+	private:
+
+		bool IsCurrent();
+
+		// Curves are their control points followed by an on-curve vertex.
+		void CheckVertices(size_t count, uint8_t controlCommand)
+		{
+			if (index + count > size || commands[index + count - 1] != BL_PATH_CMD_ON)
+			{
+				throw gcnew InvalidOperationException("Malformed path data.");
+			}
+
+			for (size_t i = 1; i < count - 1; i++)
+			{
+				if (commands[index + i] != controlCommand)
+				{
+					throw gcnew InvalidOperationException("Malformed path data.");
+				}
+			}
+		}
+
+	public:
+
+		BLPathSegmentIterator GetEnumerator()
+		{
+			return *this;
+		}
+
+		bool MoveNext()
+		{
+			if (!IsCurrent())
+			{
+				throw gcnew InvalidOperationException("Path was modified after the iterator was created.");
+			}
+
+			if (index >= size)
+			{
+				return false;
+			}
+
+			current.p0 = position;
+
+			switch (commands[index])
+			{
+			case BL_PATH_CMD_MOVE:
+				position = BLPoint(vertices[index]);
+				figureStart = position;
+				current.type = BLPathSegmentType::Move;
+				current.p0 = position;
+				index++;
+				break;
+
+			case BL_PATH_CMD_ON:
+				position = BLPoint(vertices[index]);
+				current.type = BLPathSegmentType::Line;
+				current.p1 = position;
+				index++;
+				break;
+
+			case BL_PATH_CMD_QUAD:
+				CheckVertices(2, BL_PATH_CMD_QUAD);
+				position = BLPoint(vertices[index + 1]);
+				current.type = BLPathSegmentType::Quad;
+				current.p1 = BLPoint(vertices[index]);
+				current.p2 = position;
+				index += 2;
+				break;
+
+			case BL_PATH_CMD_CUBIC:
+				CheckVertices(3, BL_PATH_CMD_CUBIC);
+				position = BLPoint(vertices[index + 2]);
+				current.type = BLPathSegmentType::Cubic;
+				current.p1 = BLPoint(vertices[index]);
+				current.p2 = BLPoint(vertices[index + 1]);
+				current.p3 = position;
+				index += 3;
+				break;
+
+			case BL_PATH_CMD_CLOSE:
+				current.type = BLPathSegmentType::Close;
+				current.p1 = figureStart;
+				position = figureStart;
+				index++;
+				break;
+
+			default:
+				throw gcnew InvalidOperationException("Malformed path data.");
+			}
+
+			return true;
+		}
+
+		void Reset()
+		{
+			index = 0;
+			position = BLPoint();
+			figureStart = BLPoint();
+		}
+
+	public:
+
+		property BLPathSegment Current
+		{
+			BLPathSegment get()
+			{
+				return current;
+			}
+		}
+	};
+
 	public ref class BLPath sealed : public BLObject
 	{
 	private:
@@ -381,6 +790,18 @@ namespace Blend2D
 		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
 		BLObjectPointer<ImplType> impl;
 
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLErrorMode errorMode = BLErrorMode::Throw;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLResultCode accumulatedError = BLResultCode::BL_SUCCESS;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		size_t accumulatedErrorCount = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t modificationCount = 0;
+
 	public:
 
 		BLPath()
@@ -400,53 +821,105 @@ namespace Blend2D
 			return impl;
 		}
 
+		bool Recycle() override
+		{
+			errorMode = BLErrorMode::Throw;
+			ResetErrors();
+			modificationCount++;
+
+			return blPathClear(this) == BL_SUCCESS;
+		}
+
+	protected:
+
+		void Destroy() override
+		{
+			modificationCount++;
+		}
+
+	internal:
+
+		BLResultCode AppendUninitialized(size_t n, uint8_t** cmdData, ::BLPoint** vtxData)
+		{
+			auto result = Modify(blPathModifyOp(this, BL_MODIFY_OP_APPEND_GROW, n, cmdData, vtxData));
+
+			ReportMemoryPressure();
+
+			return result;
+		}
+
+		BLResultCode RemoveLast(size_t n)
+		{
+			::BLRange range = { impl->size() - n, impl->size() };
+
+			return Modify(blPathRemoveRange(this, &range));
+		}
+
+		// True when the path ends in an open figure that segments can continue.
+		bool HasCurrentPoint()
+		{
+			size_t size = impl->size();
+
+			return size > 0 && impl->commandData()[size - 1] != BL_PATH_CMD_CLOSE;
+		}
+
+		// Lets BLPathBuilder report errors through the error mode of the path.
+		BLResultCode ReportError(BLResult result)
+		{
+			return CheckResult(result);
+		}
+
 	public:
 
 		// Path Construction
 
 		void Clear()
 		{
-			CheckResult(blPathClear(this));
+			Modify(blPathClear(this));
 		}
 
 		void Shrink()
 		{
-			CheckResult(blPathShrink(this));
+			Modify(blPathShrink(this));
+
+			ReportMemoryPressure();
 		}
 
 		void Reserve(size_t n)
 		{
-			CheckResult(blPathReserve(this, n));
+			Modify(blPathReserve(this, n));
+
+			ReportMemoryPressure();
 		}
 
 		void SetVertexAt(size_t index, BLPathCommand cmd, BLPoint pt)
 		{
-			CheckResult(blPathSetVertexAt(this, index, (uint32_t)cmd, pt.X, pt.Y));
+			Modify(blPathSetVertexAt(this, index, (uint32_t)cmd, pt.X, pt.Y));
 		}
 
 		void SetVertexAt(size_t index, BLPathCommand cmd, double x, double y)
 		{
-			CheckResult(blPathSetVertexAt(this, index, (uint32_t)cmd, x, y));
+			Modify(blPathSetVertexAt(this, index, (uint32_t)cmd, x, y));
 		}
 
 		void MoveTo(BLPoint p0)
 		{
-			CheckResult(blPathMoveTo(this, p0.X, p0.Y));
+			Modify(blPathMoveTo(this, p0.X, p0.Y));
 		}
 
 		void MoveTo(double x0, double y0)
 		{
-			CheckResult(blPathMoveTo(this, x0, y0));
+			Modify(blPathMoveTo(this, x0, y0));
 		}
 
 		void LineTo(BLPoint p1)
 		{
-			CheckResult(blPathLineTo(this, p1.X, p1.Y));
+			Modify(blPathLineTo(this, p1.X, p1.Y));
 		}
 
 		void LineTo(double x1, double y1)
 		{
-			CheckResult(blPathLineTo(this, x1, y1));
+			Modify(blPathLineTo(this, x1, y1));
 		}
 
 		void PolyTo(array<BLPoint>^ poly)
@@ -455,93 +928,93 @@ namespace Blend2D
 			{
 				Pin(BLPoint, pPoly, poly[0]);
 
-				CheckResult(blPathPolyTo(this, Point(pPoly), poly->Length));
+				Modify(blPathPolyTo(this, Point(pPoly), poly->Length));
 			}
 		}
 
 		void QuadTo(BLPoint p1, BLPoint p2)
 		{
-			CheckResult(blPathQuadTo(this, p1.X, p1.Y, p2.X, p2.Y));
+			Modify(blPathQuadTo(this, p1.X, p1.Y, p2.X, p2.Y));
 		}
 
 		void QuadTo(double x1, double y1, double x2, double y2)
 		{
-			CheckResult(blPathQuadTo(this, x1, y1, x2, y2));
+			Modify(blPathQuadTo(this, x1, y1, x2, y2));
 		}
 
 		void CubicTo(BLPoint p1, BLPoint p2, BLPoint p3)
 		{
-			CheckResult(blPathCubicTo(this, p1.X, p1.Y, p2.X, p2.Y, p3.X, p3.Y));
+			Modify(blPathCubicTo(this, p1.X, p1.Y, p2.X, p2.Y, p3.X, p3.Y));
 		}
 
 		void CubicTo(double x1, double y1, double x2, double y2, double x3, double y3)
 		{
-			CheckResult(blPathCubicTo(this, x1, y1, x2, y2, x3, y3));
+			Modify(blPathCubicTo(this, x1, y1, x2, y2, x3, y3));
 		}
 
 		void SmoothQuadTo(BLPoint p2)
 		{
-			CheckResult(blPathSmoothQuadTo(this, p2.X, p2.Y));
+			Modify(blPathSmoothQuadTo(this, p2.X, p2.Y));
 		}
 
 		void SmoothQuadTo(double x2, double y2)
 		{
-			CheckResult(blPathSmoothQuadTo(this, x2, y2));
+			Modify(blPathSmoothQuadTo(this, x2, y2));
 		}
 
 		void SmoothCubicTo(BLPoint p2, BLPoint p3)
 		{
-			CheckResult(blPathSmoothCubicTo(this, p2.X, p2.Y, p3.X, p3.Y));
+			Modify(blPathSmoothCubicTo(this, p2.X, p2.Y, p3.X, p3.Y));
 		}
 
 		void SmoothCubicTo(double x2, double y2, double x3, double y3)
 		{
-			CheckResult(blPathSmoothCubicTo(this, x2, y2, x3, y3));
+			Modify(blPathSmoothCubicTo(this, x2, y2, x3, y3));
 		}
 
 		void ArcTo(BLPoint c, BLPoint r, double start, double sweep)
 		{
-			CheckResult(blPathArcTo(this, c.X, c.Y, r.X, r.Y, start, sweep, false));
+			Modify(blPathArcTo(this, c.X, c.Y, r.X, r.Y, start, sweep, false));
 		}
 
 		void ArcTo(BLPoint c, BLPoint r, double start, double sweep, bool forceMoveTo)
 		{
-			CheckResult(blPathArcTo(this, c.X, c.Y, r.X, r.Y, start, sweep, forceMoveTo));
+			Modify(blPathArcTo(this, c.X, c.Y, r.X, r.Y, start, sweep, forceMoveTo));
 		}
 
 		void ArcTo(double cx, double cy, double rx, double ry, double start, double sweep)
 		{
-			CheckResult(blPathArcTo(this, cx, cy, rx, ry, start, sweep, false));
+			Modify(blPathArcTo(this, cx, cy, rx, ry, start, sweep, false));
 		}
 
 		void ArcTo(double cx, double cy, double rx, double ry, double start, double sweep, bool forceMoveTo)
 		{
-			CheckResult(blPathArcTo(this, cx, cy, rx, ry, start, sweep, forceMoveTo));
+			Modify(blPathArcTo(this, cx, cy, rx, ry, start, sweep, forceMoveTo));
 		}
 
 		void ArcQuadrantTo(BLPoint p1, BLPoint p2)
 		{
-			CheckResult(blPathArcQuadrantTo(this, p1.X, p1.Y, p2.X, p2.Y));
+			Modify(blPathArcQuadrantTo(this, p1.X, p1.Y, p2.X, p2.Y));
 		}
 
 		void ArcQuadrantTo(double x1, double y1, double x2, double y2)
 		{
-			CheckResult(blPathArcQuadrantTo(this, x1, y1, x2, y2));
+			Modify(blPathArcQuadrantTo(this, x1, y1, x2, y2));
 		}
 
 		void EllipticArcTo(BLPoint rp, double xAxisRotation, bool largeArcFlag, bool sweepFlag, BLPoint p1)
 		{
-			CheckResult(blPathEllipticArcTo(this, rp.X, rp.Y, xAxisRotation, largeArcFlag, sweepFlag, p1.X, p1.Y));
+			Modify(blPathEllipticArcTo(this, rp.X, rp.Y, xAxisRotation, largeArcFlag, sweepFlag, p1.X, p1.Y));
 		}
 
 		void EllipticArcTo(double rx, double ry, double xAxisRotation, bool largeArcFlag, bool sweepFlag, double x1, double y1)
 		{
-			CheckResult(blPathEllipticArcTo(this, rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x1, y1));
+			Modify(blPathEllipticArcTo(this, rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x1, y1));
 		}
 
 		void Close()
 		{
-			CheckResult(blPathClose(this));
+			Modify(blPathClose(this));
 		}
 
 	public:
@@ -557,7 +1030,7 @@ namespace Blend2D
 		{
 			Pin(BLBoxI, pBox, box);
 
-			CheckResult(blPathAddBoxI(this, BoxI(pBox), (uint32_t)dir));
+			Modify(blPathAddBoxI(this, BoxI(pBox), (uint32_t)dir));
 		}
 
 		void AddBox(BLBox box)
@@ -569,7 +1042,7 @@ namespace Blend2D
 		{
 			Pin(BLBox, pBox, box);
 
-			CheckResult(blPathAddBoxD(this, Box(pBox), (uint32_t)dir));
+			Modify(blPathAddBoxD(this, Box(pBox), (uint32_t)dir));
 		}
 
 		void AddBox(double x0, double y0, double x1, double y1)
@@ -591,7 +1064,7 @@ namespace Blend2D
 		{
 			Pin(BLRectI, pRect, rect);
 
-			CheckResult(blPathAddRectI(this, RectI(pRect), (uint32_t)dir));
+			Modify(blPathAddRectI(this, RectI(pRect), (uint32_t)dir));
 		}
 
 		void AddRect(BLRect rect)
@@ -603,7 +1076,7 @@ namespace Blend2D
 		{
 			Pin(BLRect, pRect, rect);
 
-			CheckResult(blPathAddRectD(this, Rect(pRect), (uint32_t)dir));
+			Modify(blPathAddRectD(this, Rect(pRect), (uint32_t)dir));
 		}
 
 		void AddRect(double x, double y, double w, double h)
@@ -861,7 +1334,7 @@ namespace Blend2D
 			{
 				Pin(BLPointI, pPoly, poly[0]);
 
-				AddGeometry(BLGeometryType::PolyLineI, pPoly, nullptr, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::PolyLineI, pPoly, poly->Length, nullptr, BLGeometryDirection::CW);
 			}
 		}
 
@@ -872,7 +1345,7 @@ namespace Blend2D
 				Pin(BLPointI, pPoly, poly[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::PolyLineI, pPoly, pMatrix, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::PolyLineI, pPoly, poly->Length, pMatrix, BLGeometryDirection::CW);
 			}
 		}
 
@@ -882,7 +1355,7 @@ namespace Blend2D
 			{
 				Pin(BLPointI, pPoly, poly[0]);
 
-				AddGeometry(BLGeometryType::PolyLineI, pPoly, nullptr, dir);
+				AddGeometryArray(BLGeometryType::PolyLineI, pPoly, poly->Length, nullptr, dir);
 			}
 		}
 
@@ -893,17 +1366,29 @@ namespace Blend2D
 				Pin(BLPointI, pPoly, poly[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::PolyLineI, pPoly, pMatrix, dir);
+				AddGeometryArray(BLGeometryType::PolyLineI, pPoly, poly->Length, pMatrix, dir);
 			}
 		}
 
+		void AddPolyLine(const BLPointI* poly, size_t count)
+		{
+			AddGeometryArray(BLGeometryType::PolyLineI, poly, count, nullptr, BLGeometryDirection::CW);
+		}
+
+		void AddPolyLine(const BLPointI* poly, size_t count, BLMatrix2D m, BLGeometryDirection dir)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			AddGeometryArray(BLGeometryType::PolyLineI, poly, count, pMatrix, dir);
+		}
+
 		void AddPolyLine(array<BLPoint>^ poly)
 		{
 			if (poly->Length > 0)
 			{
 				Pin(BLPoint, pPoly, poly[0]);
 
-				AddGeometry(BLGeometryType::PolyLine, pPoly, nullptr, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::PolyLine, pPoly, poly->Length, nullptr, BLGeometryDirection::CW);
 			}
 		}
 
@@ -914,7 +1399,7 @@ namespace Blend2D
 				Pin(BLPoint, pPoly, poly[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::PolyLine, pPoly, pMatrix, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::PolyLine, pPoly, poly->Length, pMatrix, BLGeometryDirection::CW);
 			}
 		}
 
@@ -924,7 +1409,7 @@ namespace Blend2D
 			{
 				Pin(BLPoint, pPoly, poly[0]);
 
-				AddGeometry(BLGeometryType::PolyLine, pPoly, nullptr, dir);
+				AddGeometryArray(BLGeometryType::PolyLine, pPoly, poly->Length, nullptr, dir);
 			}
 		}
 
@@ -935,17 +1420,29 @@ namespace Blend2D
 				Pin(BLPoint, pPoly, poly[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::PolyLine, pPoly, pMatrix, dir);
+				AddGeometryArray(BLGeometryType::PolyLine, pPoly, poly->Length, pMatrix, dir);
 			}
 		}
 
+		void AddPolyLine(const BLPoint* poly, size_t count)
+		{
+			AddGeometryArray(BLGeometryType::PolyLine, poly, count, nullptr, BLGeometryDirection::CW);
+		}
+
+		void AddPolyLine(const BLPoint* poly, size_t count, BLMatrix2D m, BLGeometryDirection dir)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			AddGeometryArray(BLGeometryType::PolyLine, poly, count, pMatrix, dir);
+		}
+
 		void AddPolygon(array<BLPointI>^ poly)
 		{
 			if (poly->Length > 0)
 			{
 				Pin(BLPointI, pPoly, poly[0]);
 
-				AddGeometry(BLGeometryType::PolygonI, pPoly, nullptr, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::PolygonI, pPoly, poly->Length, nullptr, BLGeometryDirection::CW);
 			}
 		}
 
@@ -956,7 +1453,7 @@ namespace Blend2D
 				Pin(BLPointI, pPoly, poly[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::PolygonI, pPoly, pMatrix, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::PolygonI, pPoly, poly->Length, pMatrix, BLGeometryDirection::CW);
 			}
 		}
 
@@ -966,7 +1463,7 @@ namespace Blend2D
 			{
 				Pin(BLPointI, pPoly, poly[0]);
 
-				AddGeometry(BLGeometryType::PolygonI, pPoly, nullptr, dir);
+				AddGeometryArray(BLGeometryType::PolygonI, pPoly, poly->Length, nullptr, dir);
 			}
 		}
 
@@ -977,17 +1474,29 @@ namespace Blend2D
 				Pin(BLPointI, pPoly, poly[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::PolygonI, pPoly, pMatrix, dir);
+				AddGeometryArray(BLGeometryType::PolygonI, pPoly, poly->Length, pMatrix, dir);
 			}
 		}
 
+		void AddPolygon(const BLPointI* poly, size_t count)
+		{
+			AddGeometryArray(BLGeometryType::PolygonI, poly, count, nullptr, BLGeometryDirection::CW);
+		}
+
+		void AddPolygon(const BLPointI* poly, size_t count, BLMatrix2D m, BLGeometryDirection dir)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			AddGeometryArray(BLGeometryType::PolygonI, poly, count, pMatrix, dir);
+		}
+
 		void AddPolygon(array<BLPoint>^ poly)
 		{
 			if (poly->Length > 0)
 			{
 				Pin(BLPoint, pPoly, poly[0]);
 
-				AddGeometry(BLGeometryType::Polygon, pPoly, nullptr, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::Polygon, pPoly, poly->Length, nullptr, BLGeometryDirection::CW);
 			}
 		}
 
@@ -998,7 +1507,7 @@ namespace Blend2D
 				Pin(BLPoint, pPoly, poly[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::Polygon, pPoly, pMatrix, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::Polygon, pPoly, poly->Length, pMatrix, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1008,7 +1517,7 @@ namespace Blend2D
 			{
 				Pin(BLPoint, pPoly, poly[0]);
 
-				AddGeometry(BLGeometryType::Polygon, pPoly, nullptr, dir);
+				AddGeometryArray(BLGeometryType::Polygon, pPoly, poly->Length, nullptr, dir);
 			}
 		}
 
@@ -1019,17 +1528,29 @@ namespace Blend2D
 				Pin(BLPoint, pPoly, poly[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::Polygon, pPoly, pMatrix, dir);
+				AddGeometryArray(BLGeometryType::Polygon, pPoly, poly->Length, pMatrix, dir);
 			}
 		}
 
+		void AddPolygon(const BLPoint* poly, size_t count)
+		{
+			AddGeometryArray(BLGeometryType::Polygon, poly, count, nullptr, BLGeometryDirection::CW);
+		}
+
+		void AddPolygon(const BLPoint* poly, size_t count, BLMatrix2D m, BLGeometryDirection dir)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			AddGeometryArray(BLGeometryType::Polygon, poly, count, pMatrix, dir);
+		}
+
 		void AddBoxArray(array<BLBoxI>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLBoxI, pArray, array[0]);
 
-				AddGeometry(BLGeometryType::BoxIArray, pArray, nullptr, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::BoxIArray, pArray, array->Length, nullptr, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1040,7 +1561,7 @@ namespace Blend2D
 				Pin(BLBoxI, pArray, array[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::BoxIArray, pArray, pMatrix, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::BoxIArray, pArray, array->Length, pMatrix, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1050,7 +1571,7 @@ namespace Blend2D
 			{
 				Pin(BLBoxI, pArray, array[0]);
 
-				AddGeometry(BLGeometryType::BoxIArray, pArray, nullptr, dir);
+				AddGeometryArray(BLGeometryType::BoxIArray, pArray, array->Length, nullptr, dir);
 			}
 		}
 
@@ -1061,17 +1582,29 @@ namespace Blend2D
 				Pin(BLBoxI, pArray, array[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::BoxIArray, pArray, pMatrix, dir);
+				AddGeometryArray(BLGeometryType::BoxIArray, pArray, array->Length, pMatrix, dir);
 			}
 		}
 
+		void AddBoxArray(const BLBoxI* array, size_t count)
+		{
+			AddGeometryArray(BLGeometryType::BoxIArray, array, count, nullptr, BLGeometryDirection::CW);
+		}
+
+		void AddBoxArray(const BLBoxI* array, size_t count, BLMatrix2D m, BLGeometryDirection dir)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			AddGeometryArray(BLGeometryType::BoxIArray, array, count, pMatrix, dir);
+		}
+
 		void AddBoxArray(array<BLBox>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLBox, pArray, array[0]);
 
-				AddGeometry(BLGeometryType::BoxArray, pArray, nullptr, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::BoxArray, pArray, array->Length, nullptr, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1082,7 +1615,7 @@ namespace Blend2D
 				Pin(BLBox, pArray, array[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::BoxArray, pArray, pMatrix, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::BoxArray, pArray, array->Length, pMatrix, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1092,7 +1625,7 @@ namespace Blend2D
 			{
 				Pin(BLBox, pArray, array[0]);
 
-				AddGeometry(BLGeometryType::BoxArray, pArray, nullptr, dir);
+				AddGeometryArray(BLGeometryType::BoxArray, pArray, array->Length, nullptr, dir);
 			}
 		}
 
@@ -1103,17 +1636,29 @@ namespace Blend2D
 				Pin(BLBox, pArray, array[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::BoxArray, pArray, pMatrix, dir);
+				AddGeometryArray(BLGeometryType::BoxArray, pArray, array->Length, pMatrix, dir);
 			}
 		}
 
+		void AddBoxArray(const BLBox* array, size_t count)
+		{
+			AddGeometryArray(BLGeometryType::BoxArray, array, count, nullptr, BLGeometryDirection::CW);
+		}
+
+		void AddBoxArray(const BLBox* array, size_t count, BLMatrix2D m, BLGeometryDirection dir)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			AddGeometryArray(BLGeometryType::BoxArray, array, count, pMatrix, dir);
+		}
+
 		void AddRectArray(array<BLRectI>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLRectI, pArray, array[0]);
 
-				AddGeometry(BLGeometryType::RectIArray, pArray, nullptr, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::RectIArray, pArray, array->Length, nullptr, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1124,7 +1669,7 @@ namespace Blend2D
 				Pin(BLRectI, pArray, array[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::RectIArray, pArray, pMatrix, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::RectIArray, pArray, array->Length, pMatrix, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1134,7 +1679,7 @@ namespace Blend2D
 			{
 				Pin(BLRectI, pArray, array[0]);
 
-				AddGeometry(BLGeometryType::RectIArray, pArray, nullptr, dir);
+				AddGeometryArray(BLGeometryType::RectIArray, pArray, array->Length, nullptr, dir);
 			}
 		}
 
@@ -1145,17 +1690,29 @@ namespace Blend2D
 				Pin(BLRectI, pArray, array[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::RectIArray, pArray, pMatrix, dir);
+				AddGeometryArray(BLGeometryType::RectIArray, pArray, array->Length, pMatrix, dir);
 			}
 		}
 
+		void AddRectArray(const BLRectI* array, size_t count)
+		{
+			AddGeometryArray(BLGeometryType::RectIArray, array, count, nullptr, BLGeometryDirection::CW);
+		}
+
+		void AddRectArray(const BLRectI* array, size_t count, BLMatrix2D m, BLGeometryDirection dir)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			AddGeometryArray(BLGeometryType::RectIArray, array, count, pMatrix, dir);
+		}
+
 		void AddRectArray(array<BLRect>^ array)
 		{
 			if (array->Length > 0)
 			{
 				Pin(BLRect, pArray, array[0]);
 
-				AddGeometry(BLGeometryType::RectArray, pArray, nullptr, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::RectArray, pArray, array->Length, nullptr, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1166,7 +1723,7 @@ namespace Blend2D
 				Pin(BLRect, pArray, array[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::RectArray, pArray, pMatrix, BLGeometryDirection::CW);
+				AddGeometryArray(BLGeometryType::RectArray, pArray, array->Length, pMatrix, BLGeometryDirection::CW);
 			}
 		}
 
@@ -1176,7 +1733,7 @@ namespace Blend2D
 			{
 				Pin(BLRect, pArray, array[0]);
 
-				AddGeometry(BLGeometryType::RectArray, pArray, nullptr, dir);
+				AddGeometryArray(BLGeometryType::RectArray, pArray, array->Length, nullptr, dir);
 			}
 		}
 
@@ -1187,31 +1744,68 @@ namespace Blend2D
 				Pin(BLRect, pArray, array[0]);
 				Pin(BLMatrix2D, pMatrix, m);
 
-				AddGeometry(BLGeometryType::RectArray, pArray, pMatrix, dir);
+				AddGeometryArray(BLGeometryType::RectArray, pArray, array->Length, pMatrix, dir);
+			}
+		}
+
+		void AddRectArray(const BLRect* array, size_t count)
+		{
+			AddGeometryArray(BLGeometryType::RectArray, array, count, nullptr, BLGeometryDirection::CW);
+		}
+
+		void AddRectArray(const BLRect* array, size_t count, BLMatrix2D m, BLGeometryDirection dir)
+		{
+			Pin(BLMatrix2D, pMatrix, m);
+
+			AddGeometryArray(BLGeometryType::RectArray, array, count, pMatrix, dir);
+		}
+
+	public:
+
+		// Adding Raw Data
+
+		void AppendRaw(array<BLPathCommand>^ commands, array<BLPoint>^ vertices, int count)
+		{
+			CheckArrayRange(commands, 0, count);
+			CheckArrayRange(vertices, 0, count);
+
+			if (count > 0)
+			{
+				Pin(BLPathCommand, pCommands, commands[0]);
+				Pin(BLPoint, pVertices, vertices[0]);
+
+				AppendRaw(pCommands, pVertices, count);
 			}
 		}
 
+		void AppendRaw(const BLPathCommand* commands, const BLPoint* vertices, size_t count)
+		{
+			Modify(AppendPathData(this, (const uint8_t*)commands, Point(vertices), count));
+
+			ReportMemoryPressure();
+		}
+
 	public:
 
 		// Adding Paths
 
 		void AddPath(BLPath^ path)
 		{
-			CheckResult(blPathAddPath(this, path, nullptr));
+			Modify(blPathAddPath(this, path, nullptr));
 		}
 
 		void AddPath(BLPath^ path, BLRange range)
 		{
 			Pin(BLRange, pRange, range);
 
-			CheckResult(blPathAddPath(this, path, Range(pRange)));
+			Modify(blPathAddPath(this, path, Range(pRange)));
 		}
 
 		void AddPath(BLPath^ path, BLPoint p)
 		{
 			Pin(BLPoint, pPoint, p);
 
-			CheckResult(blPathAddTranslatedPath(this, path, nullptr, Point(pPoint)));
+			Modify(blPathAddTranslatedPath(this, path, nullptr, Point(pPoint)));
 		}
 
 		void AddPath(BLPath^ path, BLRange range, BLPoint p)
@@ -1219,14 +1813,14 @@ namespace Blend2D
 			Pin(BLRange, pRange, range);
 			Pin(BLPoint, pPoint, p);
 
-			CheckResult(blPathAddTranslatedPath(this, path, Range(pRange), Point(pPoint)));
+			Modify(blPathAddTranslatedPath(this, path, Range(pRange), Point(pPoint)));
 		}
 
 		void AddPath(BLPath^ path, BLMatrix2D m)
 		{
 			Pin(BLMatrix2D, pMatrix, m);
 
-			CheckResult(blPathAddTransformedPath(this, path, nullptr, Matrix2D(pMatrix)));
+			Modify(blPathAddTransformedPath(this, path, nullptr, Matrix2D(pMatrix)));
 		}
 
 		void AddPath(BLPath^ path, BLRange range, BLMatrix2D m)
@@ -1234,26 +1828,26 @@ namespace Blend2D
 			Pin(BLRange, pRange, range);
 			Pin(BLMatrix2D, pMatrix, m);
 
-			CheckResult(blPathAddTransformedPath(this, path, Range(pRange), Matrix2D(pMatrix)));
+			Modify(blPathAddTransformedPath(this, path, Range(pRange), Matrix2D(pMatrix)));
 		}
 
 		void AddReversedPath(BLPath^ path, BLPathReverseMode reverseMode)
 		{
-			CheckResult(blPathAddReversedPath(this, path, nullptr, (uint32_t)reverseMode));
+			Modify(blPathAddReversedPath(this, path, nullptr, (uint32_t)reverseMode));
 		}
 
 		void AddReversedPath(BLPath^ path, BLRange range, BLPathReverseMode reverseMode)
 		{
 			Pin(BLRange, pRange, range);
 
-			CheckResult(blPathAddReversedPath(this, path, Range(pRange), (uint32_t)reverseMode));
+			Modify(blPathAddReversedPath(this, path, Range(pRange), (uint32_t)reverseMode));
 		}
 
 		void AddStrokedPath(BLPath^ path, BLStrokeOptions^ strokeOptions, BLApproximationOptions approximationOptions)
 		{
 			Pin(BLApproximationOptions, pApproximationOptions, approximationOptions);
 
-			CheckResult(blPathAddStrokedPath(this, path, nullptr, strokeOptions, ApproximationOptions(pApproximationOptions)));
+			Modify(blPathAddStrokedPath(this, path, nullptr, strokeOptions, ApproximationOptions(pApproximationOptions)));
 		}
 
 		void AddStrokedPath(BLPath^ path, BLRange range, BLStrokeOptions^ strokeOptions, BLApproximationOptions approximationOptions)
@@ -1261,7 +1855,7 @@ namespace Blend2D
 			Pin(BLRange, pRange, range);
 			Pin(BLApproximationOptions, pApproximationOptions, approximationOptions);
 
-			CheckResult(blPathAddStrokedPath(this, path, Range(pRange), strokeOptions, ApproximationOptions(pApproximationOptions)));
+			Modify(blPathAddStrokedPath(this, path, Range(pRange), strokeOptions, ApproximationOptions(pApproximationOptions)));
 		}
 
 	public:
@@ -1272,7 +1866,7 @@ namespace Blend2D
 		{
 			Pin(BLRange, pRange, range);
 
-			CheckResult(blPathRemoveRange(this, Range(pRange)));
+			Modify(blPathRemoveRange(this, Range(pRange)));
 		}
 
 	public:
@@ -1283,7 +1877,7 @@ namespace Blend2D
 		{
 			Pin(BLPoint, pPoint, p);
 
-			CheckResult(blPathTranslate(this, nullptr, Point(pPoint)));
+			Modify(blPathTranslate(this, nullptr, Point(pPoint)));
 		}
 
 		void Translate(BLRange range, BLPoint p)
@@ -1291,14 +1885,14 @@ namespace Blend2D
 			Pin(BLRange, pRange, range);
 			Pin(BLPoint, pPoint, p);
 
-			CheckResult(blPathTranslate(this, Range(pRange), Point(pPoint)));
+			Modify(blPathTranslate(this, Range(pRange), Point(pPoint)));
 		}
 
 		void Transform(BLMatrix2D m)
 		{
 			Pin(BLMatrix2D, pMatrix, m);
 
-			CheckResult(blPathTransform(this, nullptr, Matrix2D(pMatrix)));
+			Modify(blPathTransform(this, nullptr, Matrix2D(pMatrix)));
 		}
 
 		void Transform(BLRange range, BLMatrix2D m)
@@ -1306,7 +1900,7 @@ namespace Blend2D
 			Pin(BLRange, pRange, range);
 			Pin(BLMatrix2D, pMatrix, m);
 
-			CheckResult(blPathTransform(this, Range(pRange), Matrix2D(pMatrix)));
+			Modify(blPathTransform(this, Range(pRange), Matrix2D(pMatrix)));
 		}
 
 	public:
@@ -1338,15 +1932,135 @@ namespace Blend2D
 			return static_cast<BLHitTest>(blPathHitTest(this, Point(pPoint), (uint32_t)fillRule));
 		}
 
+	public:
+
+		// Non-throwing Operations
+
+		BLResultCode TryMoveTo(double x0, double y0)
+		{
+			modificationCount++;
+
+			return (BLResultCode)blPathMoveTo(this, x0, y0);
+		}
+
+		BLResultCode TryLineTo(double x1, double y1)
+		{
+			modificationCount++;
+
+			return (BLResultCode)blPathLineTo(this, x1, y1);
+		}
+
+		BLResultCode TryQuadTo(double x1, double y1, double x2, double y2)
+		{
+			modificationCount++;
+
+			return (BLResultCode)blPathQuadTo(this, x1, y1, x2, y2);
+		}
+
+		BLResultCode TryCubicTo(double x1, double y1, double x2, double y2, double x3, double y3)
+		{
+			modificationCount++;
+
+			return (BLResultCode)blPathCubicTo(this, x1, y1, x2, y2, x3, y3);
+		}
+
+		BLResultCode TryClose()
+		{
+			modificationCount++;
+
+			return (BLResultCode)blPathClose(this);
+		}
+
+		BLResultCode TryAddPolygon(const BLPoint* poly, size_t count)
+		{
+			::BLArrayView<uint8_t> view;
+			view.reset(reinterpret_cast<const uint8_t*>(poly), count);
+
+			modificationCount++;
+
+			return (BLResultCode)blPathAddGeometry(this, BL_GEOMETRY_TYPE_POLYGOND, &view, nullptr, BL_GEOMETRY_DIRECTION_CW);
+		}
+
+		BLResultCode TryAddPath(BLPath^ path)
+		{
+			modificationCount++;
+
+			return (BLResultCode)blPathAddPath(this, path, nullptr);
+		}
+
+		void ResetErrors()
+		{
+			accumulatedError = BLResultCode::BL_SUCCESS;
+			accumulatedErrorCount = 0;
+		}
+
 	private:
 
 		void AddGeometry(BLGeometryType geometryType, const void* geometryData, const BLMatrix2D* m, BLGeometryDirection dir)
 		{
-			CheckResult(blPathAddGeometry(this, (uint32_t)geometryType, geometryData, nullptr, (uint32_t)dir));
+			Modify(blPathAddGeometry(this, (uint32_t)geometryType, geometryData, Matrix2D(m), (uint32_t)dir));
+
+			ReportMemoryPressure();
+		}
+
+		// Capacity is sampled on bulk operations only, small paths stay below
+		// the reporting granularity anyway.
+		void ReportMemoryPressure()
+		{
+			SetMemoryPressure((int64_t)impl->capacity() * (sizeof(::BLPoint) + sizeof(uint8_t)));
+		}
+
+		void AddGeometryArray(BLGeometryType geometryType, const void* data, size_t size, const BLMatrix2D* m, BLGeometryDirection dir)
+		{
+			::BLArrayView<uint8_t> view;
+			view.reset(static_cast<const uint8_t*>(data), size);
+
+			AddGeometry(geometryType, &view, m, dir);
+		}
+
+		// Every mutation goes through here so views can detect stale data.
+		BLResultCode Modify(BLResult result)
+		{
+			modificationCount++;
+
+			return CheckResult(result);
+		}
+
+		BLResultCode CheckResult(BLResult result)
+		{
+			return Blend2D::CheckResult(result, errorMode, accumulatedError, accumulatedErrorCount);
 		}
 
 	public:
 
+		property BLErrorMode ErrorMode
+		{
+			BLErrorMode get()
+			{
+				return errorMode;
+			}
+			void set(BLErrorMode value)
+			{
+				errorMode = value;
+			}
+		}
+
+		property BLResultCode AccumulatedError
+		{
+			BLResultCode get()
+			{
+				return accumulatedError;
+			}
+		}
+
+		property size_t AccumulatedErrorCount
+		{
+			size_t get()
+			{
+				return accumulatedErrorCount;
+			}
+		}
+
 		property bool IsNone
 		{
 			bool get()
@@ -1402,5 +2116,292 @@ namespace Blend2D
 				return ConvertToArray<BLPathCommand>(impl->commandData(), impl->size());
 			}
 		}
+
+		property uint64_t ModificationCount
+		{
+			uint64_t get()
+			{
+				return modificationCount;
+			}
+		}
+
+		property BLPathVertexView VertexView
+		{
+			BLPathVertexView get()
+			{
+				return BLPathVertexView(this, modificationCount, impl->vertexData(), impl->size());
+			}
+		}
+
+		property BLPathCommandView CommandView
+		{
+			BLPathCommandView get()
+			{
+				return BLPathCommandView(this, modificationCount, impl->commandData(), impl->size());
+			}
+		}
+
+		property BLPathSegmentIterator Segments
+		{
+			BLPathSegmentIterator get()
+			{
+				return BLPathSegmentIterator(this, modificationCount, impl->commandData(), impl->vertexData(), impl->size());
+			}
+		}
+	};
+
+	// Streams segments straight into the native storage of a path. Space is
+	// appended in chunks through blPathModifyOp and the unused tail is trimmed
+	// by Finish, so the path must not be used until the builder is finished.
+	public ref class BLPathBuilder sealed
+	{
+	private:
+
+		literal int DefaultChunkSize = 1024;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPath^ path;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		size_t chunkSize;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint8_t* cmdData = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		::BLPoint* vtxData = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		size_t remaining = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t version = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool failed = false;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool hasCurrentPoint = false;
+
+	public:
+
+		BLPathBuilder(BLPath^ path)
+		{
+			Init(path, DefaultChunkSize);
+		}
+
+		BLPathBuilder(BLPath^ path, size_t sizeHint)
+		{
+			Init(path, sizeHint);
+		}
+
+		~BLPathBuilder()
+		{
+			Finish();
+		}
+
+	public:
+
+		void MoveTo(double x0, double y0)
+		{
+			if (Ensure(1))
+			{
+				Emit(BL_PATH_CMD_MOVE, x0, y0);
+				hasCurrentPoint = true;
+			}
+		}
+
+		void LineTo(double x1, double y1)
+		{
+			if (EnsureSegment(1))
+			{
+				Emit(BL_PATH_CMD_ON, x1, y1);
+			}
+		}
+
+		void QuadTo(double x1, double y1, double x2, double y2)
+		{
+			if (EnsureSegment(2))
+			{
+				Emit(BL_PATH_CMD_QUAD, x1, y1);
+				Emit(BL_PATH_CMD_ON, x2, y2);
+			}
+		}
+
+		void CubicTo(double x1, double y1, double x2, double y2, double x3, double y3)
+		{
+			if (EnsureSegment(3))
+			{
+				Emit(BL_PATH_CMD_CUBIC, x1, y1);
+				Emit(BL_PATH_CMD_CUBIC, x2, y2);
+				Emit(BL_PATH_CMD_ON, x3, y3);
+			}
+		}
+
+		void Close()
+		{
+			if (EnsureSegment(1))
+			{
+				Emit(BL_PATH_CMD_CLOSE, Double::NaN, Double::NaN);
+				hasCurrentPoint = false;
+			}
+		}
+
+		void Finish()
+		{
+			if (path == nullptr)
+			{
+				return;
+			}
+
+			auto target = path;
+			path = nullptr;
+
+			try
+			{
+				CheckVersion(target);
+				RemoveReserved(target);
+			}
+			finally
+			{
+				cmdData = nullptr;
+				vtxData = nullptr;
+				remaining = 0;
+			}
+		}
+
+	private:
+
+		void Init(BLPath^ path, size_t sizeHint)
+		{
+			if (path == nullptr)
+			{
+				throw gcnew ArgumentNullException("path");
+			}
+
+			this->path = path;
+			this->chunkSize = sizeHint > 0 ? sizeHint : DefaultChunkSize;
+			this->hasCurrentPoint = path->HasCurrentPoint();
+		}
+
+		void CheckVersion(BLPath^ target)
+		{
+			if (remaining > 0 && target->ModificationCount != version)
+			{
+				throw gcnew InvalidOperationException("Path was modified while it was being built.");
+			}
+		}
+
+		bool Ensure(size_t n)
+		{
+			if (path == nullptr)
+			{
+				throw gcnew ObjectDisposedException("BLPathBuilder");
+			}
+
+			if (failed)
+			{
+				return false;
+			}
+
+			// Checked on every call, the reserved pointers are stale as soon as
+			// the path was modified by someone else.
+			CheckVersion(path);
+
+			if (remaining >= n)
+			{
+				return true;
+			}
+
+			RemoveReserved(path);
+
+			uint8_t* cmd;
+			::BLPoint* vtx;
+			size_t size = n > chunkSize ? n : chunkSize;
+
+			if (path->AppendUninitialized(size, &cmd, &vtx) != BLResultCode::BL_SUCCESS)
+			{
+				failed = true;
+				return false;
+			}
+
+			cmdData = cmd;
+			vtxData = vtx;
+			remaining = size;
+			version = path->ModificationCount;
+			return true;
+		}
+
+		// Same rule as BLPath::LineTo, a segment without a current point fails
+		// the builder instead of emitting a figure that does not start with a
+		// move. Finish still trims whatever was reserved before.
+		bool EnsureSegment(size_t n)
+		{
+			if (path == nullptr)
+			{
+				throw gcnew ObjectDisposedException("BLPathBuilder");
+			}
+
+			if (!failed && !hasCurrentPoint)
+			{
+				failed = true;
+				path->ReportError(BL_ERROR_NO_MATCHING_VERTEX);
+				return false;
+			}
+
+			return Ensure(n);
+		}
+
+		// The reserved tail holds uninitialized vertices, a path that can not be
+		// trimmed is unusable, so this throws even in Accumulate mode.
+		void RemoveReserved(BLPath^ target)
+		{
+			if (remaining > 0)
+			{
+				auto result = target->RemoveLast(remaining);
+
+				remaining = 0;
+
+				if (result != BLResultCode::BL_SUCCESS)
+				{
+					failed = true;
+					Blend2D::CheckResult((BLResult)result);
+				}
+			}
+		}
+
+		void Emit(uint8_t cmd, double x, double y)
+		{
+			*cmdData++ = cmd;
+			vtxData->x = x;
+			vtxData->y = y;
+			vtxData++;
+			remaining--;
+		}
+
+	public:
+
+		property BLPath^ Path
+		{
+			BLPath^ get()
+			{
+				return path;
+			}
+		}
 	};
+
+	inline bool BLPathVertexView::IsCurrent()
+	{
+		return owner != nullptr && owner->ModificationCount == version;
+	}
+
+	inline bool BLPathCommandView::IsCurrent()
+	{
+		return owner != nullptr && owner->ModificationCount == version;
+	}
+
+	inline bool BLPathSegmentIterator::IsCurrent()
+	{
+		return owner != nullptr && owner->ModificationCount == version;
+	}
 }
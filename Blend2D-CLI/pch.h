@@ -18,6 +18,8 @@
 #include <vcclr.h>
 #include <Windows.h>
 #include <msclr\marshal.h>
+#include <malloc.h>
+#include <new>
 
 // Blend2D Includes
 #include "blend2d.h"
@@ -0,0 +1,469 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "geometry.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+namespace Blend2D
+{
+	//! Boolean operator.
+	public enum class BLBooleanOp : UInt32
+	{
+		//! Result = B.
+		Copy = BL_BOOLEAN_OP_COPY,
+		//! Result = A & B.
+		And = BL_BOOLEAN_OP_AND,
+		//! Result = A | B.
+		Or = BL_BOOLEAN_OP_OR,
+		//! Result = A ^ B.
+		Xor = BL_BOOLEAN_OP_XOR,
+		//! Result = A & ~B.
+		Sub = BL_BOOLEAN_OP_SUB,
+	};
+
+	//! Region type.
+	public enum class BLRegionType : UInt32
+	{
+		//! Region is empty (has no rectangles).
+		Empty = BL_REGION_TYPE_EMPTY,
+		//! Region has one rectangle (rectangular).
+		Rect = BL_REGION_TYPE_RECT,
+		//! Region has more YX sorted rectangles.
+		Complex = BL_REGION_TYPE_COMPLEX,
+	};
+
+	public ref class BLRegion sealed : public BLObject
+	{
+	private:
+
+		typedef ::BLRegion ImplType;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<ImplType> impl;
+
+	public:
+
+		BLRegion()
+			: BLObject()
+		{
+		}
+
+		BLRegion(BLBoxI box)
+			: BLObject()
+		{
+			Assign(box);
+		}
+
+		BLRegion(BLRectI rect)
+			: BLObject()
+		{
+			Assign(rect);
+		}
+
+	internal:
+
+		operator ImplType* ()
+		{
+			if (Object::ReferenceEquals(this, nullptr))
+			{
+				return nullptr;
+			}
+
+			return impl;
+		}
+
+		bool Recycle() override
+		{
+			return blRegionClear(this) == BL_SUCCESS;
+		}
+
+	public:
+
+		void Clear()
+		{
+			CheckResult(blRegionClear(this));
+		}
+
+		void Shrink()
+		{
+			CheckResult(blRegionShrink(this));
+		}
+
+		void Reserve(int count)
+		{
+			CheckResult(blRegionReserve(this, count));
+		}
+
+		void Assign(BLRegion^ other)
+		{
+			CheckResult(blRegionAssignWeak(this, other));
+		}
+
+		void Assign(BLBoxI box)
+		{
+			Pin(BLBoxI, pBox, box);
+
+			CheckResult(blRegionAssignBoxI(this, BoxI(pBox)));
+		}
+
+		void Assign(BLRectI rect)
+		{
+			Pin(BLRectI, pRect, rect);
+
+			CheckResult(blRegionAssignRectI(this, RectI(pRect)));
+		}
+
+		void Assign(array<BLBoxI>^ boxes)
+		{
+			Assign(boxes, 0, boxes != nullptr ? boxes->Length : 0);
+		}
+
+		void Assign(array<BLBoxI>^ boxes, int index, int count)
+		{
+			CheckArrayRange(boxes, index, count);
+
+			if (count == 0)
+			{
+				Clear();
+				return;
+			}
+
+			Pin(BLBoxI, pBoxes, boxes[index]);
+
+			CheckResult(blRegionAssignBoxIArray(this, BoxI(pBoxes), count));
+		}
+
+		void Assign(array<BLRectI>^ rects)
+		{
+			Assign(rects, 0, rects != nullptr ? rects->Length : 0);
+		}
+
+		void Assign(array<BLRectI>^ rects, int index, int count)
+		{
+			CheckArrayRange(rects, index, count);
+
+			if (count == 0)
+			{
+				Clear();
+				return;
+			}
+
+			Pin(BLRectI, pRects, rects[index]);
+
+			CheckResult(blRegionAssignRectIArray(this, RectI(pRects), count));
+		}
+
+		void Combine(BLRegion^ other, BLBooleanOp op)
+		{
+			CheckResult(blRegionCombine(this, this, other, (uint32_t)op));
+		}
+
+		void Combine(BLBoxI box, BLBooleanOp op)
+		{
+			Pin(BLBoxI, pBox, box);
+
+			CheckResult(blRegionCombineRB(this, this, BoxI(pBox), (uint32_t)op));
+		}
+
+		void Union(BLRegion^ other)
+		{
+			Combine(other, BLBooleanOp::Or);
+		}
+
+		void Union(BLBoxI box)
+		{
+			Combine(box, BLBooleanOp::Or);
+		}
+
+		void Union(BLRectI rect)
+		{
+			Combine(BLBoxI(rect.X, rect.Y, rect.X + rect.Width, rect.Y + rect.Height), BLBooleanOp::Or);
+		}
+
+		void Intersect(BLRegion^ other)
+		{
+			Combine(other, BLBooleanOp::And);
+		}
+
+		void Intersect(BLBoxI box)
+		{
+			Combine(box, BLBooleanOp::And);
+		}
+
+		void Subtract(BLRegion^ other)
+		{
+			Combine(other, BLBooleanOp::Sub);
+		}
+
+		void Subtract(BLBoxI box)
+		{
+			Combine(box, BLBooleanOp::Sub);
+		}
+
+		void Xor(BLRegion^ other)
+		{
+			Combine(other, BLBooleanOp::Xor);
+		}
+
+		void Translate(BLPointI offset)
+		{
+			Pin(BLPointI, pOffset, offset);
+
+			CheckResult(blRegionTranslate(this, this, PointI(pOffset)));
+		}
+
+		void TranslateAndClip(BLPointI offset, BLBoxI clipBox)
+		{
+			Pin(BLPointI, pOffset, offset);
+			Pin(BLBoxI, pClipBox, clipBox);
+
+			CheckResult(blRegionTranslateAndClip(this, this, PointI(pOffset), BoxI(pClipBox)));
+		}
+
+		void IntersectAndClip(BLRegion^ other, BLBoxI clipBox)
+		{
+			Pin(BLBoxI, pClipBox, clipBox);
+
+			CheckResult(blRegionIntersectAndClip(this, this, other, BoxI(pClipBox)));
+		}
+
+		BLHitTest HitTest(BLPointI point)
+		{
+			Pin(BLPointI, pPoint, point);
+
+			return (BLHitTest)blRegionHitTest(this, PointI(pPoint));
+		}
+
+		BLHitTest HitTest(BLBoxI box)
+		{
+			Pin(BLBoxI, pBox, box);
+
+			return (BLHitTest)blRegionHitTestBoxI(this, BoxI(pBox));
+		}
+
+		bool Equals(BLRegion^ other)
+		{
+			return other != nullptr && blRegionEquals(this, other);
+		}
+
+		array<BLBoxI>^ ToArray()
+		{
+			auto count = Count;
+			auto result = gcnew array<BLBoxI>(count);
+
+			if (count > 0)
+			{
+				Pin(BLBoxI, pResult, result[0]);
+
+				memcpy(pResult, impl->data(), count * sizeof(::BLBoxI));
+			}
+
+			return result;
+		}
+
+	public:
+
+		static BLRegion^ Combine(BLRegion^ a, BLRegion^ b, BLBooleanOp op)
+		{
+			auto result = gcnew BLRegion();
+
+			CheckResult(blRegionCombine(result, a, b, (uint32_t)op));
+
+			return result;
+		}
+
+	public:
+
+		property int Count
+		{
+			int get()
+			{
+				return (int)impl->size();
+			}
+		}
+
+		property BLRegionType Type
+		{
+			BLRegionType get()
+			{
+				return (BLRegionType)impl->type();
+			}
+		}
+
+		property bool IsEmpty
+		{
+			bool get()
+			{
+				return impl->empty();
+			}
+		}
+
+		property BLBoxI BoundingBox
+		{
+			BLBoxI get()
+			{
+				const auto& box = impl->boundingBox();
+
+				return BLBoxI(box.x0, box.y0, box.x1, box.y1);
+			}
+		}
+
+		property BLBoxI default[int]
+		{
+			BLBoxI get(int index)
+			{
+				if (index < 0 || index >= Count)
+				{
+					throw gcnew ArgumentOutOfRangeException("index");
+				}
+
+				const auto& box = impl->data()[index];
+
+				return BLBoxI(box.x0, box.y0, box.x1, box.y1);
+			}
+		}
+	};
+
+	// Collects invalidated areas between frames. Damage can be added from any
+	// thread, Take hands out everything collected so far as a region. When
+	// more than MaxBoxes boxes were added the damage collapses to their
+	// bounding box, which is cheaper to rasterize than many small boxes.
+	public ref class BLDamageAccumulator sealed
+	{
+	public:
+
+		literal int MaxBoxes = 32;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLRegion^ region;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Object^ sync;
+
+	public:
+
+		BLDamageAccumulator()
+		{
+			region = gcnew BLRegion();
+			sync = gcnew Object();
+		}
+
+		~BLDamageAccumulator()
+		{
+			delete region;
+		}
+
+	public:
+
+		void Add(BLBoxI box)
+		{
+			if (box.X1 <= box.X0 || box.Y1 <= box.Y0)
+			{
+				return;
+			}
+
+			Monitor::Enter(sync);
+
+			try
+			{
+				region->Union(box);
+				Coalesce();
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+		void Add(BLRectI rect)
+		{
+			Add(BLBoxI(rect.X, rect.Y, rect.X + rect.Width, rect.Y + rect.Height));
+		}
+
+		void Add(BLRegion^ damage)
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				region->Union(damage);
+				Coalesce();
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+		// Returns the accumulated damage and starts a new, empty accumulation.
+		BLRegion^ Take()
+		{
+			auto result = gcnew BLRegion();
+
+			Monitor::Enter(sync);
+
+			try
+			{
+				result->Assign(region);
+				region->Clear();
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+
+			return result;
+		}
+
+		void Clear()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				region->Clear();
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+	private:
+
+		void Coalesce()
+		{
+			if (region->Count > MaxBoxes)
+			{
+				region->Assign(region->BoundingBox);
+			}
+		}
+
+	public:
+
+		property bool IsEmpty
+		{
+			bool get()
+			{
+				Monitor::Enter(sync);
+
+				try
+				{
+					return region->IsEmpty;
+				}
+				finally
+				{
+					Monitor::Exit(sync);
+				}
+			}
+		}
+	};
+}
@@ -0,0 +1,230 @@
+#include "pch.h"
+#include "api.h"
+#include "scene.h"
+
+#include <algorithm>
+
+// The scene index is a bounding volume hierarchy built top-down by splitting
+// items at the median centroid of the longest axis. Children of an inner node
+// are adjacent in the node array and item boxes are stored in leaf order, so
+// a query walks memory mostly forward.
+#pragma managed(push, off)
+
+namespace Blend2D
+{
+	static const uint32_t SceneIndexLeafSize = 4;
+
+	static const uint32_t SceneIndexStackSize = 128;
+
+	static bool IsValidBox(const ::BLBox& box)
+	{
+		return box.x0 <= box.x1 && box.y0 <= box.y1;
+	}
+
+	static bool Intersects(const ::BLBox& a, const ::BLBox& b)
+	{
+		return a.x0 <= b.x1 && a.x1 >= b.x0 && a.y0 <= b.y1 && a.y1 >= b.y0;
+	}
+
+	static double Center(const ::BLBox& box, int axis)
+	{
+		return axis == 0 ? box.x0 + box.x1 : box.y0 + box.y1;
+	}
+
+	static void BuildNode(BLSceneIndexData* index, const ::BLBox* boxes, uint32_t nodeIndex, uint32_t start, uint32_t count, uint32_t* nodeCount)
+	{
+		auto& node = index->nodes[nodeIndex];
+		auto items = index->items + start;
+
+		node.box = boxes[items[0]];
+
+		double cx0 = Center(node.box, 0);
+		double cy0 = Center(node.box, 1);
+		double cx1 = cx0;
+		double cy1 = cy0;
+
+		for (uint32_t i = 1; i < count; i++)
+		{
+			const auto& box = boxes[items[i]];
+
+			node.box.x0 = blMin(node.box.x0, box.x0);
+			node.box.y0 = blMin(node.box.y0, box.y0);
+			node.box.x1 = blMax(node.box.x1, box.x1);
+			node.box.y1 = blMax(node.box.y1, box.y1);
+
+			cx0 = blMin(cx0, Center(box, 0));
+			cx1 = blMax(cx1, Center(box, 0));
+			cy0 = blMin(cy0, Center(box, 1));
+			cy1 = blMax(cy1, Center(box, 1));
+		}
+
+		if (count <= SceneIndexLeafSize)
+		{
+			node.start = start;
+			node.count = count;
+			return;
+		}
+
+		int axis = (cx1 - cx0) >= (cy1 - cy0) ? 0 : 1;
+		uint32_t half = count / 2;
+
+		std::nth_element(items, items + half, items + count, [boxes, axis](uint32_t a, uint32_t b)
+		{
+			return Center(boxes[a], axis) < Center(boxes[b], axis);
+		});
+
+		uint32_t left = *nodeCount;
+		*nodeCount += 2;
+
+		node.start = left;
+		node.count = 0;
+
+		BuildNode(index, boxes, left, start, half, nodeCount);
+		BuildNode(index, boxes, left + 1, start + half, count - half, nodeCount);
+	}
+
+	BLResult BuildSceneIndex(BLSceneIndexData* index, const ::BLBox* boxes, uint32_t count)
+	{
+		FreeSceneIndex(index);
+
+		if (count == 0)
+		{
+			return BL_SUCCESS;
+		}
+
+		auto items = static_cast<uint32_t*>(malloc(size_t(count) * sizeof(uint32_t)));
+		auto itemBoxes = static_cast<::BLBox*>(malloc(size_t(count) * sizeof(::BLBox)));
+		auto nodes = static_cast<BLSceneIndexNode*>(malloc(size_t(count) * 2 * sizeof(BLSceneIndexNode)));
+
+		index->items = items;
+		index->itemBoxes = itemBoxes;
+		index->nodes = nodes;
+
+		if (items == nullptr || itemBoxes == nullptr || nodes == nullptr)
+		{
+			FreeSceneIndex(index);
+			return BL_ERROR_OUT_OF_MEMORY;
+		}
+
+		uint32_t itemCount = 0;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (IsValidBox(boxes[i]))
+			{
+				items[itemCount++] = i;
+			}
+		}
+
+		index->itemCount = itemCount;
+
+		if (itemCount == 0)
+		{
+			return BL_SUCCESS;
+		}
+
+		uint32_t nodeCount = 1;
+
+		BuildNode(index, boxes, 0, 0, itemCount, &nodeCount);
+
+		for (uint32_t i = 0; i < itemCount; i++)
+		{
+			itemBoxes[i] = boxes[items[i]];
+		}
+
+		index->nodeCount = nodeCount;
+
+		return BL_SUCCESS;
+	}
+
+	void FreeSceneIndex(BLSceneIndexData* index)
+	{
+		free(index->nodes);
+		free(index->items);
+		free(index->itemBoxes);
+
+		index->nodes = nullptr;
+		index->nodeCount = 0;
+		index->items = nullptr;
+		index->itemBoxes = nullptr;
+		index->itemCount = 0;
+	}
+
+	static bool AppendResult(BLSceneQueryResult* result, uint32_t item)
+	{
+		if (result->size == result->capacity)
+		{
+			uint32_t capacity = blMax<uint32_t>(result->capacity * 2, 256);
+			auto data = static_cast<uint32_t*>(realloc(result->data, size_t(capacity) * sizeof(uint32_t)));
+
+			if (data == nullptr)
+			{
+				return false;
+			}
+
+			result->data = data;
+			result->capacity = capacity;
+		}
+
+		result->data[result->size++] = item;
+		return true;
+	}
+
+	BLResult QuerySceneIndex(const BLSceneIndexData* index, const ::BLBox* query, BLSceneQueryResult* result)
+	{
+		result->size = 0;
+
+		if (index->nodeCount == 0)
+		{
+			return BL_SUCCESS;
+		}
+
+		uint32_t stack[SceneIndexStackSize];
+		uint32_t depth = 0;
+
+		stack[depth++] = 0;
+
+		while (depth > 0)
+		{
+			const auto& node = index->nodes[stack[--depth]];
+
+			if (!Intersects(node.box, *query))
+			{
+				continue;
+			}
+
+			if (node.count == 0)
+			{
+				// Median splits keep the tree balanced, its depth is at most
+				// log2 of the item count, far below the stack size.
+				stack[depth++] = node.start + 1;
+				stack[depth++] = node.start;
+				continue;
+			}
+
+			for (uint32_t i = node.start, end = node.start + node.count; i < end; i++)
+			{
+				if (Intersects(index->itemBoxes[i], *query) && !AppendResult(result, index->items[i]))
+				{
+					return BL_ERROR_OUT_OF_MEMORY;
+				}
+			}
+		}
+
+		// Items are returned in insertion order, which is the paint order.
+		std::sort(result->data, result->data + result->size);
+
+		return BL_SUCCESS;
+	}
+
+	void FreeSceneQueryResult(BLSceneQueryResult* result)
+	{
+		free(result->data);
+
+		result->data = nullptr;
+		result->size = 0;
+		result->capacity = 0;
+	}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,663 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "geometry.h"
+#include "matrix.h"
+#include "style.h"
+#include "path.h"
+#include "context.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+
+namespace Blend2D
+{
+	//! Node of the scene index (native), leaves have count > 0 and refer to
+	//! items [start, start + count), inner nodes have children start and start + 1.
+	struct BLSceneIndexNode
+	{
+		::BLBox box;
+		uint32_t start;
+		uint32_t count;
+	};
+
+	struct BLSceneIndexData;
+	struct BLSceneQueryResult;
+
+	extern BLResult BuildSceneIndex(BLSceneIndexData* index, const ::BLBox* boxes, uint32_t count);
+	extern void FreeSceneIndex(BLSceneIndexData* index);
+	extern BLResult QuerySceneIndex(const BLSceneIndexData* index, const ::BLBox* query, BLSceneQueryResult* result);
+	extern void FreeSceneQueryResult(BLSceneQueryResult* result);
+
+	//! Bounding volume hierarchy over the node bounds of a scene (native).
+	struct BLSceneIndexData
+	{
+		BLSceneIndexNode* nodes = nullptr;
+		uint32_t nodeCount = 0;
+
+		uint32_t* items = nullptr;
+		::BLBox* itemBoxes = nullptr;
+		uint32_t itemCount = 0;
+
+		~BLSceneIndexData()
+		{
+			FreeSceneIndex(this);
+		}
+	};
+
+	//! Item indexes returned by a scene query, sorted ascending (native).
+	struct BLSceneQueryResult
+	{
+		uint32_t* data = nullptr;
+		uint32_t size = 0;
+		uint32_t capacity = 0;
+
+		~BLSceneQueryResult()
+		{
+			FreeSceneQueryResult(this);
+		}
+	};
+
+	ref class BLScene;
+
+	public ref class BLSceneNode sealed
+	{
+	private:
+
+		// Stroke bounds are inflated by this many stroke widths, which covers
+		// miter joins up to the default miter limit of 4.
+		literal double StrokeBoundsFactor = 2.0;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLPath^ path = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLStyle^ fillStyle = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLStyle^ strokeStyle = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		double strokeWidth = 1.0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLFillRule fillRule = BLFillRule::NonZero;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLMatrix2D matrix = BLMatrix2D(1.0, 0.0, 0.0, 1.0, 0.0, 0.0);
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool hasMatrix = false;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool visible = true;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLBox bounds;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		uint64_t pathModificationCount = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Object^ tag = nullptr;
+
+	internal:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLScene^ scene = nullptr;
+
+	public:
+
+		BLSceneNode()
+		{
+			UpdateBounds();
+		}
+
+		BLSceneNode(BLPath^ path, BLStyle^ fillStyle)
+			: path(path), fillStyle(fillStyle)
+		{
+			UpdateBounds();
+		}
+
+		BLSceneNode(BLPath^ path, BLStyle^ fillStyle, BLStyle^ strokeStyle, double strokeWidth)
+			: path(path), fillStyle(fillStyle), strokeStyle(strokeStyle), strokeWidth(strokeWidth)
+		{
+			UpdateBounds();
+		}
+
+	public:
+
+		// Recomputes the bounds after the path was modified in place.
+		void Invalidate()
+		{
+			UpdateBounds();
+		}
+
+	internal:
+
+		void Render(BLContext^ context)
+		{
+			if (fillStyle != nullptr)
+			{
+				context->FillRule = fillRule;
+				context->SetFillStyle(fillStyle);
+				context->FillPath(path);
+			}
+
+			if (strokeStyle != nullptr)
+			{
+				context->StrokeWidth = strokeWidth;
+				context->SetStrokeStyle(strokeStyle);
+				context->StrokePath(path);
+			}
+		}
+
+		bool Contains(BLPoint point)
+		{
+			if (!visible || path == nullptr)
+			{
+				return false;
+			}
+
+			if (hasMatrix)
+			{
+				::BLMatrix2D inverse;
+				Pin(BLMatrix2D, pMatrix, matrix);
+
+				if (blMatrix2DInvert(&inverse, Matrix2D(pMatrix)) != BL_SUCCESS)
+				{
+					return false;
+				}
+
+				auto local = inverse.mapPoint(point.X, point.Y);
+
+				point = BLPoint(local.x, local.y);
+			}
+
+			if (fillStyle != nullptr && path->HitTest(point, fillRule) == BLHitTest::In)
+			{
+				return true;
+			}
+
+			return strokeStyle != nullptr && StrokeContains(point);
+		}
+
+		// Revalidates the bounds of a path that was modified without calling
+		// Invalidate, returns true when they changed.
+		bool Refresh()
+		{
+			if (path != nullptr && path->ModificationCount != pathModificationCount)
+			{
+				UpdateBounds();
+				return true;
+			}
+
+			return false;
+		}
+
+	private:
+
+		// Tests against the stroke outline. It is built per call, hit tests only
+		// reach nodes whose bounds contain the point, so this stays rare.
+		bool StrokeContains(BLPoint point)
+		{
+			auto strokeOptions = gcnew BLStrokeOptions();
+			auto outline = gcnew BLPath();
+
+			try
+			{
+				strokeOptions->Width = strokeWidth;
+				outline->AddStrokedPath(path, strokeOptions, BLApproximationOptions::Default);
+
+				return outline->HitTest(point, BLFillRule::NonZero) == BLHitTest::In;
+			}
+			finally
+			{
+				delete outline;
+				delete strokeOptions;
+			}
+		}
+
+		void UpdateBounds()
+		{
+			// Inverted bounds are never hit by a query and skipped by the index.
+			bounds = BLBox(Double::MaxValue, Double::MaxValue, -Double::MaxValue, -Double::MaxValue);
+
+			if (path != nullptr)
+			{
+				pathModificationCount = path->ModificationCount;
+			}
+
+			if (visible && path != nullptr && !path->IsEmpty && (fillStyle != nullptr || strokeStyle != nullptr))
+			{
+				BLBox box;
+
+				path->GetBoundingBox(box);
+
+				if (strokeStyle != nullptr)
+				{
+					auto inflate = strokeWidth * StrokeBoundsFactor;
+
+					box = BLBox(box.X0 - inflate, box.Y0 - inflate, box.X1 + inflate, box.Y1 + inflate);
+				}
+
+				bounds = hasMatrix ? TransformBox(box, matrix) : box;
+			}
+
+			Changed();
+		}
+
+		void Changed();
+
+		static BLBox TransformBox(BLBox box, BLMatrix2D m)
+		{
+			auto x0 = box.X0 * m.M00;
+			auto x1 = box.X1 * m.M00;
+			auto y0 = box.Y0 * m.M10;
+			auto y1 = box.Y1 * m.M10;
+
+			auto u0 = box.X0 * m.M01;
+			auto u1 = box.X1 * m.M01;
+			auto v0 = box.Y0 * m.M11;
+			auto v1 = box.Y1 * m.M11;
+
+			return BLBox(
+				Math::Min(x0, x1) + Math::Min(y0, y1) + m.M20,
+				Math::Min(u0, u1) + Math::Min(v0, v1) + m.M21,
+				Math::Max(x0, x1) + Math::Max(y0, y1) + m.M20,
+				Math::Max(u0, u1) + Math::Max(v0, v1) + m.M21);
+		}
+
+	public:
+
+		property BLPath^ Path
+		{
+			BLPath^ get()
+			{
+				return path;
+			}
+			void set(BLPath^ value)
+			{
+				path = value;
+				UpdateBounds();
+			}
+		}
+
+		property BLStyle^ FillStyle
+		{
+			BLStyle^ get()
+			{
+				return fillStyle;
+			}
+			void set(BLStyle^ value)
+			{
+				fillStyle = value;
+				UpdateBounds();
+			}
+		}
+
+		property BLStyle^ StrokeStyle
+		{
+			BLStyle^ get()
+			{
+				return strokeStyle;
+			}
+			void set(BLStyle^ value)
+			{
+				strokeStyle = value;
+				UpdateBounds();
+			}
+		}
+
+		property double StrokeWidth
+		{
+			double get()
+			{
+				return strokeWidth;
+			}
+			void set(double value)
+			{
+				strokeWidth = value;
+				UpdateBounds();
+			}
+		}
+
+		property BLFillRule FillRule
+		{
+			BLFillRule get()
+			{
+				return fillRule;
+			}
+			void set(BLFillRule value)
+			{
+				fillRule = value;
+			}
+		}
+
+		property BLMatrix2D Matrix
+		{
+			BLMatrix2D get()
+			{
+				return matrix;
+			}
+			void set(BLMatrix2D value)
+			{
+				matrix = value;
+				hasMatrix = value.Type != BLMatrix2DType::Identity;
+				UpdateBounds();
+			}
+		}
+
+		property bool HasMatrix
+		{
+			bool get()
+			{
+				return hasMatrix;
+			}
+		}
+
+		property bool Visible
+		{
+			bool get()
+			{
+				return visible;
+			}
+			void set(bool value)
+			{
+				visible = value;
+				UpdateBounds();
+			}
+		}
+
+		// Bounds in scene coordinates, including the node matrix and stroke.
+		property BLBox Bounds
+		{
+			BLBox get()
+			{
+				return bounds;
+			}
+		}
+
+		property Object^ Tag
+		{
+			Object^ get()
+			{
+				return tag;
+			}
+			void set(Object^ value)
+			{
+				tag = value;
+			}
+		}
+	};
+
+	// Retained list of nodes painted in insertion order. Rendering and queries
+	// only visit nodes whose bounds intersect the query box, found through a
+	// bounding volume hierarchy. The hierarchy is rebuilt lazily on the first
+	// query after nodes were added, removed or changed, so edits should be
+	// batched between frames.
+	public ref class BLScene sealed : public BLObject
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<BLSceneIndexData> index;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLObjectPointer<BLSceneQueryResult> result;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		List<BLSceneNode^>^ nodes;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		array<BLBox>^ boxes = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool dirty = false;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t rebuildCount = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int lastVisibleCount = 0;
+
+	public:
+
+		BLScene()
+			: BLObject()
+		{
+			nodes = gcnew List<BLSceneNode^>();
+		}
+
+	internal:
+
+		void MarkDirty()
+		{
+			dirty = true;
+		}
+
+	public:
+
+		void Add(BLSceneNode^ node)
+		{
+			if (node == nullptr)
+			{
+				throw gcnew ArgumentNullException("node");
+			}
+
+			if (node->scene != nullptr)
+			{
+				throw gcnew InvalidOperationException("Node already belongs to a scene.");
+			}
+
+			node->scene = this;
+			nodes->Add(node);
+			dirty = true;
+		}
+
+		bool Remove(BLSceneNode^ node)
+		{
+			if (node == nullptr || node->scene != this || !nodes->Remove(node))
+			{
+				return false;
+			}
+
+			node->scene = nullptr;
+			dirty = true;
+			return true;
+		}
+
+		void Clear()
+		{
+			for each (BLSceneNode^ node in nodes)
+			{
+				node->scene = nullptr;
+			}
+
+			nodes->Clear();
+			dirty = true;
+		}
+
+		// Rebuilds the index now instead of on the next query. Also picks up
+		// paths that were modified in place without calling Invalidate.
+		void Rebuild()
+		{
+			for each (BLSceneNode^ node in nodes)
+			{
+				node->Refresh();
+			}
+
+			RebuildIndex();
+		}
+
+		// Renders the nodes intersecting viewport, given in scene coordinates.
+		// Node matrices are applied on top of the current user matrix.
+		void Render(BLContext^ context, BLBox viewport)
+		{
+			auto count = Query(viewport);
+			auto base = context->UserMatrix;
+			auto transformed = false;
+
+			lastVisibleCount = count;
+
+			try
+			{
+				for (int i = 0; i < count; i++)
+				{
+					auto node = nodes[(int)result->data[i]];
+
+					if (node->HasMatrix)
+					{
+						if (transformed)
+						{
+							context->UserMatrix = base;
+						}
+
+						context->Transform(node->Matrix);
+						transformed = true;
+					}
+					else if (transformed)
+					{
+						context->UserMatrix = base;
+						transformed = false;
+					}
+
+					node->Render(context);
+				}
+			}
+			finally
+			{
+				if (transformed)
+				{
+					context->UserMatrix = base;
+				}
+			}
+		}
+
+		// Adds the nodes whose bounds intersect box to results, in paint order.
+		void Query(BLBox box, List<BLSceneNode^>^ results)
+		{
+			auto count = Query(box);
+
+			for (int i = 0; i < count; i++)
+			{
+				results->Add(nodes[(int)result->data[i]]);
+			}
+		}
+
+		List<BLSceneNode^>^ Query(BLBox box)
+		{
+			auto results = gcnew List<BLSceneNode^>();
+
+			Query(box, results);
+
+			return results;
+		}
+
+		// Returns the topmost node containing point, or nullptr. Only nodes
+		// whose bounds contain the point are hit tested against their path.
+		BLSceneNode^ HitTest(BLPoint point)
+		{
+			auto count = Query(BLBox(point.X, point.Y, point.X, point.Y));
+
+			for (int i = count - 1; i >= 0; i--)
+			{
+				auto node = nodes[(int)result->data[i]];
+
+				if (node->Contains(point))
+				{
+					return node;
+				}
+			}
+
+			return nullptr;
+		}
+
+	private:
+
+		int Query(BLBox box)
+		{
+			if (dirty)
+			{
+				RebuildIndex();
+			}
+
+			Pin(BLBox, pBox, box);
+
+			CheckResult(QuerySceneIndex(index, Box(pBox), result));
+
+			return (int)result->size;
+		}
+
+		void RebuildIndex()
+		{
+			auto count = nodes->Count;
+
+			if (boxes == nullptr || boxes->Length < count)
+			{
+				boxes = gcnew array<BLBox>(Math::Max(count, 16));
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				boxes[i] = nodes[i]->Bounds;
+			}
+
+			Pin(BLBox, pBoxes, boxes[0]);
+
+			CheckResult(BuildSceneIndex(index, Box(pBoxes), (uint32_t)count));
+
+			SetMemoryPressure((int64_t)index->itemCount * (sizeof(uint32_t) + sizeof(::BLBox)) + (int64_t)index->nodeCount * sizeof(BLSceneIndexNode));
+
+			dirty = false;
+			rebuildCount++;
+		}
+
+	public:
+
+		property int Count
+		{
+			int get()
+			{
+				return nodes->Count;
+			}
+		}
+
+		property BLSceneNode^ default[int]
+		{
+			BLSceneNode^ get(int index)
+			{
+				return nodes[index];
+			}
+		}
+
+		// Number of nodes submitted by the last Render call.
+		property int LastVisibleCount
+		{
+			int get()
+			{
+				return lastVisibleCount;
+			}
+		}
+
+		property int64_t RebuildCount
+		{
+			int64_t get()
+			{
+				return rebuildCount;
+			}
+		}
+	};
+
+	inline void BLSceneNode::Changed()
+	{
+		if (scene != nullptr)
+		{
+			scene->MarkDirty();
+		}
+	}
+}
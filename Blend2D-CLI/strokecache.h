@@ -0,0 +1,339 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "path.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+using namespace System::Runtime::CompilerServices;
+
+namespace Blend2D
+{
+	// Memoizes BLPath::AddStrokedPath. Entries are keyed by a hash of the path
+	// content, the stroke and approximation options and the device scale. A
+	// hit compares all of them exactly, so a hash collision is a miss. Entries
+	// are evicted in least recently used order once ByteBudget is exceeded.
+	// Returned paths are shared by the cache and must not be modified; an
+	// entry whose result was modified anyway is dropped on its next lookup.
+	public ref class BLStrokeCache sealed
+	{
+	private:
+
+		value struct Key : IEquatable<Key>
+		{
+			uint64_t pathHash;
+			uint64_t paramsHash;
+
+			Key(uint64_t pathHash, uint64_t paramsHash)
+				: pathHash(pathHash), paramsHash(paramsHash)
+			{
+			}
+
+			virtual bool Equals(Key other)
+			{
+				return pathHash == other.pathHash && paramsHash == other.paramsHash;
+			}
+
+			bool Equals(Object^ other) override
+			{
+				return other != nullptr && other->GetType() == Key::typeid && Equals(safe_cast<Key>(other));
+			}
+
+			int GetHashCode() override
+			{
+				return (int)(pathHash ^ (pathHash >> 32) ^ (paramsHash * 31));
+			}
+		};
+
+		ref class Entry sealed
+		{
+		public:
+
+			Key key;
+			BLPath^ source;
+			BLStrokeOptions^ strokeOptions;
+			BLApproximationOptions approximationOptions;
+			double scale;
+			BLPath^ result;
+			uint64_t resultModificationCount;
+			int64_t bytes;
+		};
+
+		// Content hash of a path instance, valid while its modification count
+		// did not change, so unchanged paths are not rehashed every frame.
+		ref class PathHash sealed
+		{
+		public:
+
+			uint64_t modificationCount;
+			uint64_t hash;
+		};
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Dictionary<Key, LinkedListNode<Entry^>^>^ entries;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		LinkedList<Entry^>^ lru;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		ConditionalWeakTable<BLPath^, PathHash^>^ pathHashes;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t byteBudget;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t bytesHeld = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t hits = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t misses = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t evictions = 0;
+
+	public:
+
+		BLStrokeCache(int64_t byteBudget)
+		{
+			if (byteBudget < 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("byteBudget");
+			}
+
+			this->byteBudget = byteBudget;
+			this->entries = gcnew Dictionary<Key, LinkedListNode<Entry^>^>();
+			this->lru = gcnew LinkedList<Entry^>();
+			this->pathHashes = gcnew ConditionalWeakTable<BLPath^, PathHash^>();
+		}
+
+	public:
+
+		BLPath^ GetStrokedPath(BLPath^ path, BLStrokeOptions^ strokeOptions)
+		{
+			return GetStrokedPath(path, strokeOptions, BLApproximationOptions::Default, 1.0);
+		}
+
+		// Scale is the device scale the result is drawn at. Approximation
+		// tolerances are divided by it, so zoomed-in strokes stay smooth.
+		BLPath^ GetStrokedPath(BLPath^ path, BLStrokeOptions^ strokeOptions, BLApproximationOptions approximationOptions, double scale)
+		{
+			if (path == nullptr)
+			{
+				throw gcnew ArgumentNullException("path");
+			}
+
+			if (strokeOptions == nullptr)
+			{
+				throw gcnew ArgumentNullException("strokeOptions");
+			}
+
+			if (!(scale > 0.0))
+			{
+				throw gcnew ArgumentOutOfRangeException("scale");
+			}
+
+			Pin(BLApproximationOptions, pApproximationOptions, approximationOptions);
+
+			auto key = Key(GetPathHash(path), HashStrokeParams(strokeOptions, ApproximationOptions(pApproximationOptions), scale));
+
+			LinkedListNode<Entry^>^ node;
+
+			if (entries->TryGetValue(key, node))
+			{
+				auto entry = node->Value;
+
+				Pin(BLApproximationOptions, pCachedOptions, entry->approximationOptions);
+
+				// Paths sharing data compare by pointer, so this is cheap unless
+				// the caller modified its path since it was cached.
+				if (entry->result->ModificationCount == entry->resultModificationCount
+					&& entry->scale == scale
+					&& StrokeParamsEqual(entry->strokeOptions, ApproximationOptions(pCachedOptions), strokeOptions, ApproximationOptions(pApproximationOptions))
+					&& blPathEquals(entry->source, path))
+				{
+					lru->Remove(node);
+					lru->AddFirst(node);
+					hits++;
+					return entry->result;
+				}
+
+				Remove(node);
+			}
+
+			misses++;
+
+			auto scaled = approximationOptions;
+
+			if (scale != 1.0)
+			{
+				scaled.FlattenTolerance = approximationOptions.FlattenTolerance / scale;
+				scaled.SimplifyTolerance = approximationOptions.SimplifyTolerance / scale;
+			}
+
+			// Cached paths outlive the object pool of the calling thread.
+			auto pool = BLObjectPool::Suspend();
+			auto entry = gcnew Entry();
+
+			try
+			{
+				entry->source = gcnew BLPath();
+				entry->strokeOptions = gcnew BLStrokeOptions();
+				entry->result = gcnew BLPath();
+			}
+			finally
+			{
+				BLObjectPool::Resume(pool);
+			}
+
+			auto result = entry->result;
+
+			result->AddStrokedPath(path, strokeOptions, scaled);
+
+			entry->key = key;
+			entry->approximationOptions = approximationOptions;
+			entry->scale = scale;
+			entry->resultModificationCount = result->ModificationCount;
+			entry->bytes = EntryBytes(path) + EntryBytes(result);
+
+			if (entry->bytes <= byteBudget)
+			{
+				CheckResult(blPathAssignWeak(entry->source, path));
+				CheckResult(blStrokeOptionsAssignWeak(entry->strokeOptions, strokeOptions));
+
+				entries[key] = lru->AddFirst(entry);
+				bytesHeld += entry->bytes;
+
+				Trim(byteBudget);
+			}
+
+			return result;
+		}
+
+		void Clear()
+		{
+			entries->Clear();
+			lru->Clear();
+			bytesHeld = 0;
+		}
+
+		void ResetStatistics()
+		{
+			hits = 0;
+			misses = 0;
+			evictions = 0;
+		}
+
+	private:
+
+		uint64_t GetPathHash(BLPath^ path)
+		{
+			PathHash^ cached;
+
+			if (pathHashes->TryGetValue(path, cached))
+			{
+				if (cached->modificationCount == path->ModificationCount)
+				{
+					return cached->hash;
+				}
+			}
+			else
+			{
+				cached = gcnew PathHash();
+				pathHashes->Add(path, cached);
+			}
+
+			cached->modificationCount = path->ModificationCount;
+			cached->hash = HashPathData(path);
+
+			return cached->hash;
+		}
+
+		static int64_t EntryBytes(BLPath^ path)
+		{
+			return (int64_t)path->Size * (sizeof(::BLPoint) + sizeof(uint8_t));
+		}
+
+		void Remove(LinkedListNode<Entry^>^ node)
+		{
+			entries->Remove(node->Value->key);
+			lru->Remove(node);
+			bytesHeld -= node->Value->bytes;
+		}
+
+		void Trim(int64_t budget)
+		{
+			while (bytesHeld > budget && lru->Count > 0)
+			{
+				Remove(lru->Last);
+				evictions++;
+			}
+		}
+
+	public:
+
+		property int64_t ByteBudget
+		{
+			int64_t get()
+			{
+				return byteBudget;
+			}
+			void set(int64_t value)
+			{
+				if (value < 0)
+				{
+					throw gcnew ArgumentOutOfRangeException("value");
+				}
+
+				byteBudget = value;
+				Trim(byteBudget);
+			}
+		}
+
+		// Estimated bytes of the source and stroked vertex data held by entries.
+		property int64_t BytesHeld
+		{
+			int64_t get()
+			{
+				return bytesHeld;
+			}
+		}
+
+		property int Count
+		{
+			int get()
+			{
+				return entries->Count;
+			}
+		}
+
+		property int64_t Hits
+		{
+			int64_t get()
+			{
+				return hits;
+			}
+		}
+
+		property int64_t Misses
+		{
+			int64_t get()
+			{
+				return misses;
+			}
+		}
+
+		property int64_t Evictions
+		{
+			int64_t get()
+			{
+				return evictions;
+			}
+		}
+	};
+}
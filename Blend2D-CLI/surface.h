@@ -0,0 +1,210 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "image.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+
+namespace Blend2D
+{
+	// Resizable render target backed by a larger image. The backing image is
+	// allocated in coarse buckets and only grows while resizing, Image is a
+	// view of its top-left logical size, so most resizes only recreate the
+	// view. The backing image shrinks once the logical area stayed below a
+	// quarter of it for ShrinkDelay consecutive resizes.
+	public ref class BLSurface sealed
+	{
+	public:
+
+		literal int BucketAlignment = 128;
+
+		literal int ShrinkDelay = 32;
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Func<int, int, BLImage^>^ factory;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLImage^ backing = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLImage^ view = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int width = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int height = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int shrinkCount = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t allocationCount = 0;
+
+	public:
+
+		BLSurface(Func<int, int, BLImage^>^ factory)
+		{
+			if (factory == nullptr)
+			{
+				throw gcnew ArgumentNullException("factory");
+			}
+
+			this->factory = factory;
+		}
+
+		~BLSurface()
+		{
+			Release();
+		}
+
+	public:
+
+		// Changes the logical size. Returns true when the backing image had to
+		// be reallocated, in which case its previous content is lost.
+		bool Resize(int width, int height)
+		{
+			width = Math::Max(width, 0);
+			height = Math::Max(height, 0);
+
+			if (width == this->width && height == this->height && (view != nullptr || width == 0 || height == 0))
+			{
+				return false;
+			}
+
+			this->width = width;
+			this->height = height;
+
+			if (view != nullptr)
+			{
+				delete view;
+				view = nullptr;
+			}
+
+			if (width == 0 || height == 0)
+			{
+				return false;
+			}
+
+			auto reallocate = backing == nullptr || width > backing->Width || height > backing->Height;
+
+			if (!reallocate && (int64_t)width * height * 4 < (int64_t)backing->Width * backing->Height)
+			{
+				reallocate = ++shrinkCount >= ShrinkDelay;
+			}
+			else
+			{
+				shrinkCount = 0;
+			}
+
+			if (reallocate)
+			{
+				if (backing != nullptr)
+				{
+					delete backing;
+					backing = nullptr;
+				}
+
+				backing = factory(BucketSize(width), BucketSize(height));
+				shrinkCount = 0;
+				allocationCount++;
+			}
+
+			view = gcnew BLImage(backing, width, height);
+
+			return reallocate;
+		}
+
+		void Release()
+		{
+			if (view != nullptr)
+			{
+				delete view;
+				view = nullptr;
+			}
+
+			if (backing != nullptr)
+			{
+				delete backing;
+				backing = nullptr;
+			}
+
+			width = 0;
+			height = 0;
+			shrinkCount = 0;
+		}
+
+		// Rounds a size up by a quarter for headroom and then to BucketAlignment.
+		static int BucketSize(int size)
+		{
+			auto bucket = (int64_t)size + size / 4;
+
+			bucket = (bucket + BucketAlignment - 1) & ~(int64_t)(BucketAlignment - 1);
+
+			return (int)Math::Min(bucket, (int64_t)Int32::MaxValue & ~(int64_t)(BucketAlignment - 1));
+		}
+
+	public:
+
+		// The render target, nullptr while the logical size is empty.
+		property BLImage^ Image
+		{
+			BLImage^ get()
+			{
+				return view;
+			}
+		}
+
+		property BLImage^ Backing
+		{
+			BLImage^ get()
+			{
+				return backing;
+			}
+		}
+
+		property int Width
+		{
+			int get()
+			{
+				return width;
+			}
+		}
+
+		property int Height
+		{
+			int get()
+			{
+				return height;
+			}
+		}
+
+		property int CapacityWidth
+		{
+			int get()
+			{
+				return backing != nullptr ? backing->Width : 0;
+			}
+		}
+
+		property int CapacityHeight
+		{
+			int get()
+			{
+				return backing != nullptr ? backing->Height : 0;
+			}
+		}
+
+		property int64_t AllocationCount
+		{
+			int64_t get()
+			{
+				return allocationCount;
+			}
+		}
+	};
+}
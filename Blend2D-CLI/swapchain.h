@@ -0,0 +1,424 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "geometry.h"
+#include "image.h"
+#include "surface.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+namespace Blend2D
+{
+	public interface class IBLPresenter
+	{
+		void Present(BLImage^ image, BLRectI area);
+	};
+
+	// Presenter without a window, it only records what it was asked to present.
+	public ref class BLHeadlessPresenter sealed : IBLPresenter
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLImage^ lastImage = nullptr;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		BLRectI lastArea;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t presentCount = 0;
+
+	public:
+
+		virtual void Present(BLImage^ image, BLRectI area)
+		{
+			lastImage = image;
+			lastArea = area;
+			presentCount++;
+		}
+
+	public:
+
+		property BLImage^ LastImage
+		{
+			BLImage^ get()
+			{
+				return lastImage;
+			}
+		}
+
+		property BLRectI LastArea
+		{
+			BLRectI get()
+			{
+				return lastArea;
+			}
+		}
+
+		property int64_t PresentCount
+		{
+			int64_t get()
+			{
+				return presentCount;
+			}
+		}
+	};
+
+	// Rotates two or three images between a rendering thread and a presenting
+	// thread. The renderer never gets the front image and a finished frame is
+	// published under the lock, so a presenter always sees a complete frame.
+	// With three buffers a newer frame replaces one that was not presented yet,
+	// with two buffers the renderer waits for the presenter instead. Buffers
+	// are BLSurface instances, so resizing rarely reallocates them.
+	public ref class BLSwapChain sealed
+	{
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		array<BLSurface^>^ buffers;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Object^ sync;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int front = -1;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int ready = -1;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int rendering = -1;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		bool closed = false;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t submittedCount = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t presentedCount = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t droppedCount = 0;
+
+	public:
+
+		BLSwapChain(int bufferCount, Func<int, int, BLImage^>^ factory)
+		{
+			if (bufferCount < 2 || bufferCount > 3)
+			{
+				throw gcnew ArgumentOutOfRangeException("bufferCount");
+			}
+
+			if (factory == nullptr)
+			{
+				throw gcnew ArgumentNullException("factory");
+			}
+
+			this->buffers = gcnew array<BLSurface^>(bufferCount);
+			this->sync = gcnew Object();
+
+			for (int i = 0; i < bufferCount; i++)
+			{
+				buffers[i] = gcnew BLSurface(factory);
+			}
+		}
+
+		~BLSwapChain()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				closed = true;
+				WaitForRenderer();
+				DisposeBuffers();
+				Monitor::PulseAll(sync);
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+	public:
+
+		// Makes AcquireBack return nullptr from now on, which also wakes a
+		// renderer that waits for a buffer the presenter will never release.
+		void Close()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				closed = true;
+
+				Monitor::PulseAll(sync);
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+		// Resizes all buffers. Waits for a frame that is currently being
+		// rendered, a pending frame is discarded. The front frame stays
+		// presentable unless its backing image had to be reallocated.
+		void Resize(int width, int height)
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				WaitForRenderer();
+
+				if (width == Width && height == Height)
+				{
+					return;
+				}
+
+				for (int i = 0; i < buffers->Length; i++)
+				{
+					if (buffers[i]->Resize(width, height) && i == front)
+					{
+						front = -1;
+					}
+				}
+
+				if (buffers[0]->Image == nullptr)
+				{
+					front = -1;
+				}
+
+				ready = -1;
+
+				Monitor::PulseAll(sync);
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+		// Returns the image to render the next frame into, or nullptr when the
+		// swap chain has no buffers or was closed. Blocks while all buffers are
+		// in use.
+		BLImage^ AcquireBack()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				if (rendering != -1)
+				{
+					throw gcnew InvalidOperationException("A frame is already being rendered.");
+				}
+
+				for (;;)
+				{
+					if (closed || buffers[0]->Image == nullptr)
+					{
+						return nullptr;
+					}
+
+					for (int i = 0; i < buffers->Length; i++)
+					{
+						if (i != front && i != ready)
+						{
+							rendering = i;
+							return buffers[i]->Image;
+						}
+					}
+
+					Monitor::Wait(sync);
+				}
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+		void SubmitBack()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				if (rendering == -1)
+				{
+					throw gcnew InvalidOperationException("No frame is being rendered.");
+				}
+
+				if (ready != -1)
+				{
+					droppedCount++;
+				}
+
+				ready = rendering;
+				rendering = -1;
+				submittedCount++;
+
+				Monitor::PulseAll(sync);
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+		void CancelBack()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				rendering = -1;
+
+				Monitor::PulseAll(sync);
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+		// Swaps in the newest finished frame, if any, and presents the front
+		// image. Returns false when no frame has been finished yet.
+		bool Present(IBLPresenter^ presenter, BLRectI area)
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				if (ready != -1)
+				{
+					front = ready;
+					ready = -1;
+					presentedCount++;
+
+					Monitor::PulseAll(sync);
+				}
+
+				if (front == -1)
+				{
+					return false;
+				}
+
+				presenter->Present(buffers[front]->Image, area);
+				return true;
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+	private:
+
+		void WaitForRenderer()
+		{
+			while (rendering != -1)
+			{
+				Monitor::Wait(sync);
+			}
+		}
+
+		void DisposeBuffers()
+		{
+			for (int i = 0; i < buffers->Length; i++)
+			{
+				buffers[i]->Release();
+			}
+
+			front = -1;
+			ready = -1;
+		}
+
+	public:
+
+		property int BufferCount
+		{
+			int get()
+			{
+				return buffers->Length;
+			}
+		}
+
+		// Index of the buffer returned by AcquireBack, -1 when no frame is
+		// being rendered.
+		property int BackIndex
+		{
+			int get()
+			{
+				return rendering;
+			}
+		}
+
+		property int Width
+		{
+			int get()
+			{
+				return buffers[0]->Width;
+			}
+		}
+
+		property int Height
+		{
+			int get()
+			{
+				return buffers[0]->Height;
+			}
+		}
+
+		property int64_t AllocationCount
+		{
+			int64_t get()
+			{
+				int64_t count = 0;
+
+				for (int i = 0; i < buffers->Length; i++)
+				{
+					count += buffers[i]->AllocationCount;
+				}
+
+				return count;
+			}
+		}
+
+		property bool HasPendingFrame
+		{
+			bool get()
+			{
+				return ready != -1;
+			}
+		}
+
+		property int64_t SubmittedCount
+		{
+			int64_t get()
+			{
+				return submittedCount;
+			}
+		}
+
+		property int64_t PresentedCount
+		{
+			int64_t get()
+			{
+				return presentedCount;
+			}
+		}
+
+		property int64_t DroppedCount
+		{
+			int64_t get()
+			{
+				return droppedCount;
+			}
+		}
+	};
+}
@@ -0,0 +1,371 @@
+#pragma once
+
+#include "api.h"
+#include "object.h"
+#include "font.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+namespace Blend2D
+{
+	// Memoizes text shaping. Entries are keyed by font face, size, font
+	// features and the string, and hold the shaped glyph buffer so that
+	// repeated labels skip text conversion and shaping and are drawn as a
+	// glyph run. Entries are evicted in least recently used order once
+	// ByteBudget is exceeded. All members are safe to call from any thread.
+	public ref class BLTextRunCache sealed
+	{
+	public:
+
+		literal int64_t DefaultByteBudget = 4 * 1024 * 1024;
+
+	private:
+
+		value struct Key : IEquatable<Key>
+		{
+			IntPtr face;
+			float size;
+			uint64_t featuresHash;
+			String^ text;
+
+			Key(IntPtr face, float size, uint64_t featuresHash, String^ text)
+				: face(face), size(size), featuresHash(featuresHash), text(text)
+			{
+			}
+
+			virtual bool Equals(Key other)
+			{
+				return face == other.face && size == other.size && featuresHash == other.featuresHash && String::Equals(text, other.text);
+			}
+
+			bool Equals(Object^ other) override
+			{
+				return other != nullptr && other->GetType() == Key::typeid && Equals(safe_cast<Key>(other));
+			}
+
+			int GetHashCode() override
+			{
+				return text->GetHashCode() ^ face.GetHashCode() ^ (int)(featuresHash ^ (featuresHash >> 32)) ^ (size.GetHashCode() * 31);
+			}
+		};
+
+		ref class Entry sealed
+		{
+		public:
+
+			Key key;
+			BLFont^ font;
+			BLGlyphBuffer^ glyphBuffer;
+			int64_t bytes;
+		};
+
+	private:
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Object^ sync;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		Dictionary<Key, LinkedListNode<Entry^>^>^ entries;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		LinkedList<Entry^>^ lru;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t byteBudget;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t bytesHeld = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t hits = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t misses = 0;
+
+		[DebuggerBrowsableAttribute(DebuggerBrowsableState::Never)]
+		int64_t evictions = 0;
+
+	public:
+
+		BLTextRunCache()
+			: BLTextRunCache(DefaultByteBudget)
+		{
+		}
+
+		BLTextRunCache(int64_t byteBudget)
+		{
+			if (byteBudget < 0)
+			{
+				throw gcnew ArgumentOutOfRangeException("byteBudget");
+			}
+
+			this->byteBudget = byteBudget;
+			this->sync = gcnew Object();
+			this->entries = gcnew Dictionary<Key, LinkedListNode<Entry^>^>();
+			this->lru = gcnew LinkedList<Entry^>();
+		}
+
+	public:
+
+		// Returns the shaped glyphs of text. The buffer is shared by the cache
+		// and all threads using it, it must not be modified. Evicted buffers
+		// are not destroyed, so a returned buffer stays valid while referenced.
+		BLGlyphBuffer^ GetGlyphBuffer(BLFont^ font, String^ text)
+		{
+			if (font == nullptr)
+			{
+				throw gcnew ArgumentNullException("font");
+			}
+
+			if (text == nullptr)
+			{
+				throw gcnew ArgumentNullException("text");
+			}
+
+			const ::BLFont* native = font;
+
+			auto key = Key(IntPtr(native->face().impl), native->size(), HashFeatures(native), text);
+
+			LinkedListNode<Entry^>^ node;
+
+			Monitor::Enter(sync);
+
+			try
+			{
+				if (entries->TryGetValue(key, node))
+				{
+					if (SameFeatures(node->Value->font, native))
+					{
+						lru->Remove(node);
+						lru->AddFirst(node);
+						hits++;
+						return node->Value->glyphBuffer;
+					}
+
+					Remove(node);
+				}
+
+				misses++;
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+
+			// Shaping runs outside of the lock, so other threads only wait for
+			// dictionary updates. Concurrent misses of the same text both shape
+			// it and the last one is kept.
+			auto entry = gcnew Entry();
+
+			entry->key = key;
+
+			// Entries outlive the object pool of the calling thread.
+			auto pool = BLObjectPool::Suspend();
+
+			try
+			{
+				entry->font = gcnew BLFont();
+				entry->glyphBuffer = gcnew BLGlyphBuffer();
+			}
+			finally
+			{
+				BLObjectPool::Resume(pool);
+			}
+
+			entry->glyphBuffer->SetText(text);
+
+			font->Shape(entry->glyphBuffer);
+
+			entry->bytes = (int64_t)text->Length * sizeof(wchar_t) + (int64_t)entry->glyphBuffer->Size * (sizeof(uint32_t) + sizeof(::BLGlyphPlacement));
+
+			if (entry->bytes > byteBudget)
+			{
+				return entry->glyphBuffer;
+			}
+
+			// The entry keeps a weak copy of the font, which keeps the face alive
+			// so its address can not be reused by another face while cached.
+			CheckResult(blFontAssignWeak(entry->font, native));
+
+			Monitor::Enter(sync);
+
+			try
+			{
+				if (entries->TryGetValue(key, node))
+				{
+					Remove(node);
+				}
+
+				entries[key] = lru->AddFirst(entry);
+				bytesHeld += entry->bytes;
+
+				Trim(byteBudget);
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+
+			return entry->glyphBuffer;
+		}
+
+		void Clear()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				entries->Clear();
+				lru->Clear();
+				bytesHeld = 0;
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+		void ResetStatistics()
+		{
+			Monitor::Enter(sync);
+
+			try
+			{
+				hits = 0;
+				misses = 0;
+				evictions = 0;
+			}
+			finally
+			{
+				Monitor::Exit(sync);
+			}
+		}
+
+	private:
+
+		static uint64_t HashFeatures(const ::BLFont* font)
+		{
+			const auto& features = font->features();
+
+			uint64_t hash = features.size();
+
+			for (size_t i = 0; i < features.size(); i++)
+			{
+				hash = (hash ^ (((uint64_t)features[i].tag << 32) | features[i].value)) * 0x100000001B3ull;
+			}
+
+			return hash;
+		}
+
+		static bool SameFeatures(const ::BLFont* a, const ::BLFont* b)
+		{
+			const auto& aFeatures = a->features();
+			const auto& bFeatures = b->features();
+
+			if (aFeatures.size() != bFeatures.size())
+			{
+				return false;
+			}
+
+			return aFeatures.empty() || memcmp(aFeatures.data(), bFeatures.data(), aFeatures.size() * sizeof(::BLFontFeature)) == 0;
+		}
+
+		void Remove(LinkedListNode<Entry^>^ node)
+		{
+			entries->Remove(node->Value->key);
+			lru->Remove(node);
+			bytesHeld -= node->Value->bytes;
+		}
+
+		void Trim(int64_t budget)
+		{
+			while (bytesHeld > budget && lru->Count > 0)
+			{
+				Remove(lru->Last);
+				evictions++;
+			}
+		}
+
+	public:
+
+		property int64_t ByteBudget
+		{
+			int64_t get()
+			{
+				return Interlocked::Read(byteBudget);
+			}
+			void set(int64_t value)
+			{
+				if (value < 0)
+				{
+					throw gcnew ArgumentOutOfRangeException("value");
+				}
+
+				Monitor::Enter(sync);
+
+				try
+				{
+					byteBudget = value;
+					Trim(byteBudget);
+				}
+				finally
+				{
+					Monitor::Exit(sync);
+				}
+			}
+		}
+
+		// Estimated bytes of the strings and shaped glyph data held by entries.
+		property int64_t BytesHeld
+		{
+			int64_t get()
+			{
+				return Interlocked::Read(bytesHeld);
+			}
+		}
+
+		property int Count
+		{
+			int get()
+			{
+				Monitor::Enter(sync);
+
+				try
+				{
+					return entries->Count;
+				}
+				finally
+				{
+					Monitor::Exit(sync);
+				}
+			}
+		}
+
+		property int64_t Hits
+		{
+			int64_t get()
+			{
+				return Interlocked::Read(hits);
+			}
+		}
+
+		property int64_t Misses
+		{
+			int64_t get()
+			{
+				return Interlocked::Read(misses);
+			}
+		}
+
+		property int64_t Evictions
+		{
+			int64_t get()
+			{
+				return Interlocked::Read(evictions);
+			}
+		}
+	};
+}
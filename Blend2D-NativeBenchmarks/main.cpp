@@ -0,0 +1,189 @@
+// Create/destroy throughput of the core allocator used by BLObjectPointer,
+// compared with the plain operator new/delete path it replaced. Each thread
+// allocates a batch of blocks and frees it again, like a frame that creates
+// and disposes its wrapper objects. Runs single- and multi-threaded, and with
+// blocks freed by another thread, which is what finalizers do.
+
+#include "allocator.h"
+
+#include <stdio.h>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace Blend2D;
+
+namespace
+{
+	const size_t BatchSize = 1024;
+	const size_t RoundCount = 2000;
+	const int MeasuredRuns = 5;
+
+	// Sizes of the cores wrapped today: 8 bytes for most BL*Core structs,
+	// larger for BLStrokeOptionsCore and the command buffer.
+	const size_t CoreSizes[] = { 8, 32, 64 };
+
+	struct CoreAllocator
+	{
+		static const char* Name() { return "core allocator"; }
+		static void* Alloc(size_t size) { return AllocCore(size); }
+		static void Free(void* block, size_t size) { FreeCore(block, size); }
+	};
+
+	struct HeapAllocator
+	{
+		static const char* Name() { return "operator new/delete"; }
+		static void* Alloc(size_t size) { return ::operator new(size); }
+		static void Free(void* block, size_t) { ::operator delete(block); }
+	};
+
+	template<typename Allocator>
+	void Churn(size_t size)
+	{
+		void* blocks[BatchSize];
+
+		for (size_t round = 0; round < RoundCount; round++)
+		{
+			for (size_t i = 0; i < BatchSize; i++)
+			{
+				blocks[i] = Allocator::Alloc(size);
+				*static_cast<volatile uint8_t*>(blocks[i]) = 0;
+			}
+
+			for (size_t i = 0; i < BatchSize; i++)
+			{
+				Allocator::Free(blocks[i], size);
+			}
+		}
+	}
+
+	// Every thread allocates batches that the next thread frees.
+	template<typename Allocator>
+	void CrossThreadChurn(size_t size, int threadCount)
+	{
+		std::vector<std::vector<void*>> batches(threadCount, std::vector<void*>(BatchSize * RoundCount / 8));
+		std::vector<std::thread> threads;
+
+		for (int t = 0; t < threadCount; t++)
+		{
+			threads.emplace_back([&, t]()
+			{
+				for (auto& block : batches[t])
+				{
+					block = Allocator::Alloc(size);
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		threads.clear();
+
+		for (int t = 0; t < threadCount; t++)
+		{
+			threads.emplace_back([&, t]()
+			{
+				for (auto block : batches[(t + 1) % threadCount])
+				{
+					Allocator::Free(block, size);
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	template<typename Func>
+	double Measure(Func func)
+	{
+		double best = 1e300;
+
+		func();
+
+		for (int run = 0; run < MeasuredRuns; run++)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			func();
+
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+			if (elapsed.count() < best)
+			{
+				best = elapsed.count();
+			}
+		}
+
+		return best;
+	}
+
+	void Report(const char* scenario, const char* allocator, size_t size, int threadCount, size_t operations, double milliseconds)
+	{
+		printf("%-14s %-20s %4zu B %3d thr %10.2f ms %8.2f ns/op\n", scenario, allocator, size, threadCount, milliseconds, milliseconds * 1e6 / (double)operations);
+	}
+
+	template<typename Allocator>
+	void Run(size_t size, int threadCount)
+	{
+		size_t operations = BatchSize * RoundCount * (size_t)threadCount;
+
+		auto churn = Measure([&]()
+		{
+			std::vector<std::thread> threads;
+
+			for (int t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back(Churn<Allocator>, size);
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+		});
+
+		Report("churn", Allocator::Name(), size, threadCount, operations, churn);
+
+		if (threadCount > 1)
+		{
+			auto cross = Measure([&]()
+			{
+				CrossThreadChurn<Allocator>(size, threadCount);
+			});
+
+			Report("cross-thread", Allocator::Name(), size, threadCount, operations / 8, cross);
+		}
+	}
+}
+
+int main()
+{
+	int maxThreads = (int)std::thread::hardware_concurrency();
+
+	if (maxThreads < 2)
+	{
+		maxThreads = 2;
+	}
+
+	for (size_t size : CoreSizes)
+	{
+		for (int threadCount : { 1, maxThreads })
+		{
+			Run<HeapAllocator>(size, threadCount);
+			Run<CoreAllocator>(size, threadCount);
+		}
+	}
+
+	BLCoreAllocatorStats stats;
+	GetCoreAllocatorStats(&stats);
+
+	printf("\ncore allocations %lld, live %lld, slabs %lld\n", (long long)stats.allocationCount, (long long)stats.liveCount, (long long)stats.slabCount);
+	return stats.liveCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+﻿using System;
+
+namespace Tests
+{
+    internal sealed class AssertException : Exception
+    {
+        public AssertException(string message)
+            : base(message)
+        {
+        }
+    }
+
+    internal static class Assert
+    {
+        #region -- public methods --
+
+        public static void IsTrue(bool condition, string message)
+        {
+            if (!condition)
+            {
+                throw new AssertException(message);
+            }
+        }
+
+        public static void AreEqual<T>(T expected, T actual, string message)
+        {
+            if (!Equals(expected, actual))
+            {
+                throw new AssertException($"{message} Expected <{expected}>, actual <{actual}>.");
+            }
+        }
+
+        public static void IsNull(object value, string message)
+        {
+            IsTrue(value == null, message);
+        }
+
+        public static void IsNotNull(object value, string message)
+        {
+            IsTrue(value != null, message);
+        }
+
+        public static T Throws<T>(Action action, string message) where T : Exception
+        {
+            try
+            {
+                action();
+            }
+            catch (T e)
+            {
+                return e;
+            }
+
+            throw new AssertException($"{message} Expected {typeof(T).Name}.");
+        }
+
+        #endregion -- public methods --
+    }
+}
@@ -0,0 +1,120 @@
+﻿using System;
+using Blend2D;
+
+namespace Tests
+{
+    // Figures have to start with a move, both in raw data appended to a path
+    // and in segments streamed through BLPathBuilder.
+    public static class PathTests
+    {
+        #region -- tests --
+
+        [Test]
+        public static void AppendRawRejectsFigureWithoutMove()
+        {
+            using (var path = new BLPath())
+            {
+                Assert.Throws<InvalidOperationException>(() => AppendRaw(path, BLPathCommand.On, BLPathCommand.On), "Segment without a move was appended.");
+                Assert.IsTrue(path.Size == 0, "Rejected data was appended.");
+            }
+        }
+
+        [Test]
+        public static void AppendRawRejectsSegmentAfterClose()
+        {
+            using (var path = new BLPath())
+            {
+                Assert.Throws<InvalidOperationException>(() => AppendRaw(path, BLPathCommand.Move, BLPathCommand.On, BLPathCommand.Close, BLPathCommand.On), "Segment after a close was appended.");
+                Assert.IsTrue(path.Size == 0, "Rejected data was appended.");
+
+                path.MoveTo(0, 0);
+                path.Close();
+
+                Assert.Throws<InvalidOperationException>(() => AppendRaw(path, BLPathCommand.On), "Segment after the closed path was appended.");
+            }
+        }
+
+        [Test]
+        public static void AppendRawContinuesOpenFigure()
+        {
+            using (var path = new BLPath())
+            {
+                path.MoveTo(0, 0);
+
+                AppendRaw(path, BLPathCommand.On, BLPathCommand.Quad, BLPathCommand.On, BLPathCommand.Close, BLPathCommand.Move);
+
+                Assert.IsTrue(path.Size == 6, "Raw data was not appended.");
+            }
+        }
+
+        [Test]
+        public static void BuilderRejectsSegmentWithoutMove()
+        {
+            using (var path = new BLPath())
+            {
+                using (var builder = new BLPathBuilder(path))
+                {
+                    Assert.Throws<InvalidOperationException>(() => builder.LineTo(1, 1), "Line without a move was emitted.");
+                }
+
+                Assert.IsTrue(path.Size == 0, "Builder emitted a segment without a move.");
+            }
+        }
+
+        [Test]
+        public static void BuilderFailsAfterCloseInAccumulateMode()
+        {
+            using (var path = new BLPath())
+            {
+                path.ErrorMode = BLErrorMode.Accumulate;
+
+                using (var builder = new BLPathBuilder(path))
+                {
+                    builder.MoveTo(0, 0);
+                    builder.LineTo(1, 0);
+                    builder.Close();
+                    builder.CubicTo(1, 1, 2, 2, 3, 3);
+                    builder.MoveTo(4, 4);
+                }
+
+                Assert.AreEqual(BLResultCode.BL_ERROR_NO_MATCHING_VERTEX, path.AccumulatedError, "Error was not reported to the path.");
+                Assert.IsTrue(path.Size == 3, "Builder kept emitting after it failed.");
+            }
+        }
+
+        [Test]
+        public static void BuilderContinuesOpenFigure()
+        {
+            using (var path = new BLPath())
+            {
+                path.MoveTo(0, 0);
+
+                using (var builder = new BLPathBuilder(path))
+                {
+                    builder.LineTo(1, 1);
+                    builder.QuadTo(2, 2, 3, 3);
+                }
+
+                Assert.IsTrue(path.Size == 4, "Builder did not continue the open figure.");
+            }
+        }
+
+        #endregion -- tests --
+
+        #region -- private methods --
+
+        private static void AppendRaw(BLPath path, params BLPathCommand[] commands)
+        {
+            var vertices = new BLPoint[commands.Length];
+
+            for (int i = 0; i < vertices.Length; i++)
+            {
+                vertices[i] = commands[i] == BLPathCommand.Close ? new BLPoint(double.NaN, double.NaN) : new BLPoint(i, i);
+            }
+
+            path.AppendRaw(commands, vertices, commands.Length);
+        }
+
+        #endregion -- private methods --
+    }
+}
@@ -0,0 +1,61 @@
+﻿using System;
+using System.Diagnostics;
+using System.Linq;
+using System.Reflection;
+
+namespace Tests
+{
+    static class Program
+    {
+        #region -- main --
+
+        // Runs all tests, or those whose name contains one of the arguments.
+        // The exit code is the number of failed tests.
+        static int Main(string[] args)
+        {
+            var tests = Assembly.GetExecutingAssembly().GetTypes()
+                .SelectMany(type => type.GetMethods(BindingFlags.Public | BindingFlags.Static))
+                .Where(method => method.IsDefined(typeof(TestAttribute), false))
+                .Where(method => args.Length == 0 || args.Any(filter => FullName(method).IndexOf(filter, StringComparison.OrdinalIgnoreCase) >= 0))
+                .OrderBy(FullName)
+                .ToArray();
+
+            var failed = 0;
+
+            foreach (var test in tests)
+            {
+                var watch = Stopwatch.StartNew();
+
+                try
+                {
+                    test.Invoke(null, null);
+
+                    Console.WriteLine("PASS {0} ({1:N0} ms)", FullName(test), watch.Elapsed.TotalMilliseconds);
+                }
+                catch (TargetInvocationException e)
+                {
+                    failed++;
+
+                    Console.WriteLine("FAIL {0} ({1:N0} ms)", FullName(test), watch.Elapsed.TotalMilliseconds);
+                    Console.WriteLine("     {0}", e.InnerException);
+                }
+            }
+
+            Console.WriteLine();
+            Console.WriteLine("{0} passed, {1} failed.", tests.Length - failed, failed);
+
+            return failed;
+        }
+
+        #endregion -- main --
+
+        #region -- private methods --
+
+        private static string FullName(MethodInfo method)
+        {
+            return method.DeclaringType.Name + "." + method.Name;
+        }
+
+        #endregion -- private methods --
+    }
+}
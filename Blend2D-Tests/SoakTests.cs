@@ -0,0 +1,134 @@
+﻿using System;
+using System.Diagnostics;
+using System.Threading;
+using Blend2D;
+
+namespace Tests
+{
+    // Allocates and drops native-heavy objects for a long time without
+    // disposing them, so all memory comes back through finalizers and the
+    // native release queue. Checks that the working set and the release
+    // queue stay bounded, which depends on the memory pressure reported to
+    // the GC and on the release thread keeping up.
+    public static class SoakTests
+    {
+        #region -- const --
+
+        private const string FontFile = "Resources\\NotoSans-Regular.ttf";
+
+        private const int Rounds = 600;
+
+        private const int ImageSize = 2048;
+
+        private const int PathVertexCount = 20000;
+
+        private const int SampleInterval = 10;
+
+        // 600 rounds churn roughly 10 GB of pixels, far more than the bound.
+        private const long WorkingSetBound = 768L * 1024 * 1024;
+
+        private const long PendingReleaseBound = 20000;
+
+        private static readonly TimeSpan DrainTimeout = TimeSpan.FromSeconds(10);
+
+        #endregion -- const --
+
+        #region -- tests --
+
+        [Test]
+        public static void UndisposedObjectsStayBounded()
+        {
+            for (int i = 0; i < SampleInterval; i++)
+            {
+                AllocateAndDrop(i);
+            }
+
+            Drain();
+
+            var baseline = WorkingSet();
+            var baselineLive = BLCoreAllocator.LiveCount;
+            var peakWorkingSet = 0L;
+            var peakPending = 0L;
+
+            for (int i = 0; i < Rounds; i++)
+            {
+                AllocateAndDrop(i);
+
+                if (i % SampleInterval == 0)
+                {
+                    peakWorkingSet = Math.Max(peakWorkingSet, WorkingSet() - baseline);
+                    peakPending = Math.Max(peakPending, BLCoreAllocator.PendingReleaseCount);
+
+                    Assert.IsTrue(peakWorkingSet < WorkingSetBound, $"Working set grew by {peakWorkingSet / (1024 * 1024)} MB after {i} rounds.");
+                    Assert.IsTrue(peakPending < PendingReleaseBound, $"{peakPending} cores are waiting for release after {i} rounds.");
+                }
+            }
+
+            Drain();
+
+            Assert.AreEqual(0L, BLCoreAllocator.PendingReleaseCount, "Release queue was not drained.");
+            Assert.IsTrue(BLCoreAllocator.LiveCount <= baselineLive + 64, $"{BLCoreAllocator.LiveCount - baselineLive} cores leaked.");
+
+            Console.WriteLine("     peak working set +{0:N0} MB, peak pending releases {1:N0}", peakWorkingSet / (1024 * 1024), peakPending);
+        }
+
+        #endregion -- tests --
+
+        #region -- private methods --
+
+        private static void AllocateAndDrop(int round)
+        {
+            var image = new BLImage(ImageSize, ImageSize, BLFormat.PRGB32);
+            var context = new BLContext(image);
+
+            // Touches every page, untouched pixels would not count in the
+            // working set.
+            context.FillAll();
+            context.End();
+
+            var path = new BLPath();
+
+            path.MoveTo(0, 0);
+
+            for (int i = 1; i < PathVertexCount; i++)
+            {
+                path.LineTo(i % ImageSize, (i * 7 + round) % ImageSize);
+            }
+
+            var face = new BLFontFace(FontFile);
+            var font = new BLFont(face, 12.0f + round % 8);
+
+            GC.KeepAlive(font);
+        }
+
+        private static void Drain()
+        {
+            var watch = Stopwatch.StartNew();
+
+            do
+            {
+                GC.Collect();
+                GC.WaitForPendingFinalizers();
+                GC.Collect();
+
+                if (BLCoreAllocator.PendingReleaseCount == 0)
+                {
+                    return;
+                }
+
+                Thread.Sleep(10);
+            }
+            while (watch.Elapsed < DrainTimeout);
+        }
+
+        private static long WorkingSet()
+        {
+            using (var process = Process.GetCurrentProcess())
+            {
+                return process.WorkingSet64;
+            }
+        }
+
+        #endregion -- private methods --
+    }
+}
@@ -0,0 +1,250 @@
+﻿using System;
+using System.Threading.Tasks;
+using Blend2D;
+
+namespace Tests
+{
+    // Drives BLSwapChain from the test thread as presenter and from thread
+    // pool tasks as a blocked renderer, presenting through
+    // BLHeadlessPresenter.
+    public static class SwapChainTests
+    {
+        #region -- const --
+
+        private const int Size = 64;
+
+        // How long a call has to stay blocked to count as waiting.
+        private static readonly TimeSpan BlockedTimeout = TimeSpan.FromMilliseconds(200);
+
+        private static readonly TimeSpan ReleaseTimeout = TimeSpan.FromSeconds(5);
+
+        #endregion -- const --
+
+        #region -- tests --
+
+        [Test]
+        public static void TwoBuffersAlternate()
+        {
+            using (var chain = CreateChain(2))
+            {
+                var presenter = new BLHeadlessPresenter();
+
+                Assert.IsTrue(!chain.Present(presenter, Area()), "Presented before a frame was finished.");
+
+                var previous = -1;
+
+                for (int i = 0; i < 6; i++)
+                {
+                    var back = chain.AcquireBack();
+                    var index = chain.BackIndex;
+
+                    Assert.IsTrue(index != previous, $"Frame {i} reused the front buffer {index}.");
+
+                    chain.SubmitBack();
+
+                    Assert.IsTrue(chain.Present(presenter, Area()), $"Frame {i} was not presented.");
+                    Assert.IsTrue(ReferenceEquals(back, presenter.LastImage), $"Frame {i} presented the wrong image.");
+
+                    previous = index;
+                }
+
+                Assert.AreEqual(6L, chain.PresentedCount, "Presented frames.");
+                Assert.AreEqual(0L, chain.DroppedCount, "Dropped frames.");
+            }
+        }
+
+        [Test]
+        public static void ThreeBuffersRotateWithoutBlocking()
+        {
+            using (var chain = CreateChain(3))
+            {
+                var presenter = new BLHeadlessPresenter();
+
+                chain.AcquireBack();
+                chain.SubmitBack();
+                chain.Present(presenter, Area());
+
+                // Front and pending frame are both taken, the third buffer is
+                // still free.
+                var first = chain.AcquireBack();
+                var firstIndex = chain.BackIndex;
+
+                chain.SubmitBack();
+
+                var second = chain.AcquireBack();
+                var secondIndex = chain.BackIndex;
+
+                Assert.IsTrue(firstIndex != secondIndex, "Renderer got the pending buffer.");
+
+                chain.SubmitBack();
+                chain.Present(presenter, Area());
+
+                Assert.IsTrue(ReferenceEquals(second, presenter.LastImage), "Newest frame was not presented.");
+                Assert.IsTrue(!ReferenceEquals(first, presenter.LastImage), "Replaced frame was presented.");
+            }
+        }
+
+        [Test]
+        public static void ThreeBuffersDropUnpresentedFrames()
+        {
+            using (var chain = CreateChain(3))
+            {
+                var presenter = new BLHeadlessPresenter();
+
+                for (int i = 0; i < 5; i++)
+                {
+                    chain.AcquireBack();
+                    chain.SubmitBack();
+                }
+
+                chain.Present(presenter, Area());
+
+                Assert.AreEqual(5L, chain.SubmittedCount, "Submitted frames.");
+                Assert.AreEqual(4L, chain.DroppedCount, "Dropped frames.");
+                Assert.AreEqual(1L, chain.PresentedCount, "Presented frames.");
+                Assert.IsTrue(!chain.HasPendingFrame, "Frame still pending after Present.");
+            }
+        }
+
+        [Test]
+        public static void TwoBuffersRendererWaitsForPresenter()
+        {
+            using (var chain = CreateChain(2))
+            {
+                var presenter = new BLHeadlessPresenter();
+
+                FillBothBuffers(chain, presenter);
+
+                var acquire = Task.Run(() => chain.AcquireBack());
+
+                Assert.IsTrue(!acquire.Wait(BlockedTimeout), "Renderer got a buffer while front and pending frame were taken.");
+
+                chain.Present(presenter, Area());
+
+                Assert.IsTrue(acquire.Wait(ReleaseTimeout), "Present did not release the renderer.");
+                Assert.IsTrue(!ReferenceEquals(acquire.Result, presenter.LastImage), "Renderer got the front buffer.");
+
+                chain.SubmitBack();
+            }
+        }
+
+        [Test]
+        public static void ResizeWaitsForRenderingFrame()
+        {
+            using (var chain = CreateChain(2))
+            {
+                chain.AcquireBack();
+                chain.SubmitBack();
+                chain.AcquireBack();
+
+                var resize = Task.Run(() => chain.Resize(Size * 4, Size * 4));
+
+                Assert.IsTrue(!resize.Wait(BlockedTimeout), "Resize did not wait for the frame being rendered.");
+
+                chain.SubmitBack();
+
+                Assert.IsTrue(resize.Wait(ReleaseTimeout), "SubmitBack did not release Resize.");
+                Assert.AreEqual(Size * 4, chain.Width, "Width after Resize.");
+                Assert.IsTrue(!chain.HasPendingFrame, "Pending frame of the old size survived Resize.");
+
+                var back = chain.AcquireBack();
+
+                Assert.AreEqual(Size * 4, back.Width, "Back buffer width after Resize.");
+
+                chain.SubmitBack();
+            }
+        }
+
+        [Test]
+        public static void CloseReleasesBlockedRenderer()
+        {
+            using (var chain = CreateChain(2))
+            {
+                var presenter = new BLHeadlessPresenter();
+
+                FillBothBuffers(chain, presenter);
+
+                var acquire = Task.Run(() => chain.AcquireBack());
+
+                Assert.IsTrue(!acquire.Wait(BlockedTimeout), "Renderer was not blocked.");
+
+                chain.Close();
+
+                Assert.IsTrue(acquire.Wait(ReleaseTimeout), "Close did not release the renderer.");
+                Assert.IsNull(acquire.Result, "Closed swap chain returned a buffer.");
+                Assert.IsTrue(chain.Present(presenter, Area()), "Closed swap chain lost its front frame.");
+            }
+        }
+
+        [Test]
+        public static void DisposeReleasesBlockedRenderer()
+        {
+            var chain = CreateChain(2);
+            var presenter = new BLHeadlessPresenter();
+
+            FillBothBuffers(chain, presenter);
+
+            var acquire = Task.Run(() => chain.AcquireBack());
+
+            Assert.IsTrue(!acquire.Wait(BlockedTimeout), "Renderer was not blocked.");
+
+            chain.Dispose();
+
+            Assert.IsTrue(acquire.Wait(ReleaseTimeout), "Dispose did not release the renderer.");
+            Assert.IsNull(acquire.Result, "Disposed swap chain returned a buffer.");
+        }
+
+        [Test]
+        public static void DisposeWaitsForRenderingFrame()
+        {
+            var chain = CreateChain(2);
+
+            var back = chain.AcquireBack();
+            var dispose = Task.Run(() => chain.Dispose());
+
+            Assert.IsTrue(!dispose.Wait(BlockedTimeout), "Dispose did not wait for the frame being rendered.");
+
+            // The renderer still owns its buffer until it gives it back.
+            using (var context = new BLContext(back))
+            {
+                context.FillAll();
+                context.End();
+            }
+
+            chain.CancelBack();
+
+            Assert.IsTrue(dispose.Wait(ReleaseTimeout), "CancelBack did not release Dispose.");
+        }
+
+        #endregion -- tests --
+
+        #region -- private methods --
+
+        private static BLSwapChain CreateChain(int bufferCount)
+        {
+            var chain = new BLSwapChain(bufferCount, (width, height) => new BLImage(width, height, BLFormat.PRGB32));
+
+            chain.Resize(Size, Size);
+
+            return chain;
+        }
+
+        private static BLRectI Area()
+        {
+            return new BLRectI(0, 0, Size, Size);
+        }
+
+        // Leaves one frame in front and one pending, so a two-buffer chain has
+        // no buffer left for the renderer.
+        private static void FillBothBuffers(BLSwapChain chain, BLHeadlessPresenter presenter)
+        {
+            chain.AcquireBack();
+            chain.SubmitBack();
+            chain.Present(presenter, Area());
+            chain.AcquireBack();
+            chain.SubmitBack();
+        }
+
+        #endregion -- private methods --
+    }
+}
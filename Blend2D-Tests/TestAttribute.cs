@@ -0,0 +1,11 @@
+﻿using System;
+
+namespace Tests
+{
+    // Marks a public static method without parameters as a test. Tests fail
+    // by throwing, usually through Assert.
+    [AttributeUsage(AttributeTargets.Method)]
+    internal sealed class TestAttribute : Attribute
+    {
+    }
+}